@@ -0,0 +1,321 @@
+#pragma once
+
+#include "dense_poly.cpp"
+#include "sparse_poly.cpp"
+#include <variant>
+#include <iterator>
+
+template<typename T, typename Alloc = std::allocator<T>>
+class AdaptivePolynomial {
+private:
+    using Dense = dense::Polynomial<T, Alloc>;
+    using Sparse = sparse::Polynomial<T, Alloc>;
+
+    std::variant<Dense, Sparse> data;
+
+    static bool prefer_dense(size_t terms, long long degree) {
+        return degree < static_cast<long long>(small_degree) ||
+               static_cast<double>(terms) >= density_threshold * static_cast<double>(degree + 1);
+    }
+
+    static size_t saturating_product(size_t a, size_t b) {
+        if (a != 0 && b > std::numeric_limits<size_t>::max() / a) {
+            return std::numeric_limits<size_t>::max();
+        }
+        return a * b;
+    }
+
+    size_t terms() const {
+        if (is_dense()) {
+            const Dense &p = std::get<Dense>(data);
+            return std::count_if(p.begin(), p.end(), [](const T &x) {
+                return x != T(0);
+            });
+        } else {
+            const Sparse &p = std::get<Sparse>(data);
+            return std::distance(p.begin(), p.end());
+        }
+    }
+
+    void normalize() {
+        bool dense = prefer_dense(terms(), Degree());
+        if (dense && !is_dense()) {
+            data = to_dense();
+        } else if (!dense && is_dense()) {
+            data = to_sparse();
+        }
+    }
+
+    template<typename DenseOp, typename SparseOp>
+    AdaptivePolynomial apply(const AdaptivePolynomial &other, bool dense, DenseOp dense_op,
+                             SparseOp sparse_op) const {
+        AdaptivePolynomial ans(T(0), get_allocator());
+        if (dense) {
+            ans.data = dense_op(to_dense(), other.to_dense());
+        } else {
+            ans.data = sparse_op(to_sparse(), other.to_sparse());
+        }
+        ans.normalize();
+        return ans;
+    }
+
+public:
+    using allocator_type = Alloc;
+
+    static inline double density_threshold = 0.1;
+    static inline size_t small_degree = 64;
+
+    explicit AdaptivePolynomial(const std::vector<T> &input, const Alloc &alloc = Alloc())
+            : data(Dense(input, alloc)) {
+        normalize();
+    }
+
+    explicit AdaptivePolynomial(const T &scalar = T(), const Alloc &alloc = Alloc()) : data(Dense(scalar, alloc)) {
+    }
+
+    template<typename Iter>
+    AdaptivePolynomial(Iter first, Iter last, const Alloc &alloc = Alloc()) : data(Dense(first, last, alloc)) {
+        normalize();
+    }
+
+    explicit AdaptivePolynomial(const Dense &p) : data(p) {
+        normalize();
+    }
+
+    explicit AdaptivePolynomial(const Sparse &p) : data(p) {
+        normalize();
+    }
+
+    allocator_type get_allocator() const {
+        return std::visit([](const auto &p) {
+            return p.get_allocator();
+        }, data);
+    }
+
+    bool is_dense() const {
+        return std::holds_alternative<Dense>(data);
+    }
+
+    Dense to_dense() const {
+        if (is_dense()) {
+            return Dense(std::get<Dense>(data), get_allocator());
+        } else {
+            const Sparse &p = std::get<Sparse>(data);
+            std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>> temp(
+                    p.Degree() + 1, T(0), get_allocator());
+            for (auto it = p.begin(); it != p.end(); ++it) {
+                temp[it->first] = it->second;
+            }
+            return Dense(temp.begin(), temp.end(), get_allocator());
+        }
+    }
+
+    Sparse to_sparse() const {
+        if (is_dense()) {
+            const Dense &p = std::get<Dense>(data);
+            return Sparse(p.begin(), p.end(), get_allocator());
+        } else {
+            return Sparse(std::get<Sparse>(data), get_allocator());
+        }
+    }
+
+    bool operator==(const AdaptivePolynomial &other) const {
+        if (is_dense() && other.is_dense()) {
+            return std::get<Dense>(data) == std::get<Dense>(other.data);
+        } else {
+            return to_sparse() == other.to_sparse();
+        }
+    }
+
+    bool operator==(const T &scalar) const {
+        return *this == AdaptivePolynomial(scalar, get_allocator());
+    }
+
+    friend bool operator==(const T &scalar, const AdaptivePolynomial &expr) {
+        return expr == AdaptivePolynomial(scalar, expr.get_allocator());
+    }
+
+    bool operator!=(const AdaptivePolynomial &other) const {
+        return !(*this == other);
+    }
+
+    bool operator!=(const T &scalar) const {
+        return !(*this == AdaptivePolynomial(scalar, get_allocator()));
+    }
+
+    friend bool operator!=(const T &scalar, const AdaptivePolynomial &expr) {
+        return !(expr == AdaptivePolynomial(scalar, expr.get_allocator()));
+    }
+
+    T operator[](size_t i) const {
+        return std::visit([i](const auto &p) {
+            return p[i];
+        }, data);
+    }
+
+    long long int Degree() const {
+        return std::visit([](const auto &p) {
+            return p.Degree();
+        }, data);
+    }
+
+    AdaptivePolynomial &operator+=(const AdaptivePolynomial &other) {
+        return *this = *this + other;
+    }
+
+    AdaptivePolynomial &operator+=(const T &scalar) {
+        return *this += AdaptivePolynomial(scalar, get_allocator());
+    }
+
+    AdaptivePolynomial &operator-=(const AdaptivePolynomial &other) {
+        return *this = *this - other;
+    }
+
+    AdaptivePolynomial &operator-=(const T &scalar) {
+        return *this -= AdaptivePolynomial(scalar, get_allocator());
+    }
+
+    AdaptivePolynomial &operator*=(const AdaptivePolynomial &other) {
+        return *this = *this * other;
+    }
+
+    AdaptivePolynomial &operator*=(const T &scalar) {
+        std::visit([&scalar](auto &p) {
+            p *= scalar;
+        }, data);
+        return *this;
+    }
+
+    AdaptivePolynomial operator+(const AdaptivePolynomial &other) const {
+        bool dense = prefer_dense(terms() + other.terms(), std::max(Degree(), other.Degree()));
+        return apply(other, dense, [](const Dense &a, const Dense &b) {
+            return a + b;
+        }, [](const Sparse &a, const Sparse &b) {
+            return a + b;
+        });
+    }
+
+    AdaptivePolynomial operator+(const T &scalar) const {
+        return *this + AdaptivePolynomial(scalar, get_allocator());
+    }
+
+    friend AdaptivePolynomial operator+(const T &scalar, const AdaptivePolynomial &expr) {
+        return AdaptivePolynomial(scalar, expr.get_allocator()) + expr;
+    }
+
+    AdaptivePolynomial operator-(const AdaptivePolynomial &other) const {
+        bool dense = prefer_dense(terms() + other.terms(), std::max(Degree(), other.Degree()));
+        return apply(other, dense, [](const Dense &a, const Dense &b) {
+            return a - b;
+        }, [](const Sparse &a, const Sparse &b) {
+            return a - b;
+        });
+    }
+
+    AdaptivePolynomial operator-(const T &scalar) const {
+        return *this - AdaptivePolynomial(scalar, get_allocator());
+    }
+
+    friend AdaptivePolynomial operator-(const T &scalar, const AdaptivePolynomial &expr) {
+        return AdaptivePolynomial(scalar, expr.get_allocator()) - expr;
+    }
+
+    AdaptivePolynomial operator*(const AdaptivePolynomial &other) const {
+        if (Degree() == -1 || other.Degree() == -1) {
+            return AdaptivePolynomial(T(0), get_allocator());
+        }
+        long long degree = Degree() + other.Degree();
+        size_t estimate = std::min(saturating_product(terms(), other.terms()), static_cast<size_t>(degree + 1));
+        return apply(other, prefer_dense(estimate, degree), [](const Dense &a, const Dense &b) {
+            return a * b;
+        }, [](const Sparse &a, const Sparse &b) {
+            return a * b;
+        });
+    }
+
+    AdaptivePolynomial operator*(const T &scalar) const {
+        AdaptivePolynomial temp = *this;
+        temp *= scalar;
+        return temp;
+    }
+
+    friend AdaptivePolynomial operator*(const T &scalar, const AdaptivePolynomial &other) {
+        AdaptivePolynomial temp = other;
+        temp *= scalar;
+        return temp;
+    }
+
+    T operator ()(const T& scalar) const {
+        return std::visit([&scalar](const auto &p) {
+            return p(scalar);
+        }, data);
+    }
+
+    AdaptivePolynomial power(long long int n) const {
+        if (n < 0) {
+            throw std::invalid_argument("Negative exponent");
+        }
+        AdaptivePolynomial ans(T(1), get_allocator());
+        AdaptivePolynomial base = *this;
+        while (n != 0) {
+            if (n & 1) {
+                ans *= base;
+            }
+            n >>= 1;
+            if (n != 0) {
+                base *= base;
+            }
+        }
+        return ans;
+    }
+
+    AdaptivePolynomial operator & (const AdaptivePolynomial& other) const {
+        if (Degree() <= 0) {
+            return AdaptivePolynomial((*this)[0], get_allocator());
+        }
+        if (other.Degree() <= 0) {
+            return AdaptivePolynomial((*this)(other[0]), get_allocator());
+        }
+        long long degree = Degree() * other.Degree();
+        size_t estimate = std::min(saturating_product(terms(), other.Degree() + 1), static_cast<size_t>(degree + 1));
+        return apply(other, prefer_dense(estimate, degree), [](const Dense &a, const Dense &b) {
+            return a & b;
+        }, [](const Sparse &a, const Sparse &b) {
+            return a & b;
+        });
+    }
+
+    AdaptivePolynomial operator / (const AdaptivePolynomial& divider) const {
+        bool dense = prefer_dense(terms() + divider.terms(), Degree());
+        return apply(divider, dense, [](const Dense &a, const Dense &b) {
+            return a / b;
+        }, [](const Sparse &a, const Sparse &b) {
+            return a / b;
+        });
+    }
+
+    AdaptivePolynomial operator % (const AdaptivePolynomial& divider) const {
+        bool dense = prefer_dense(terms() + divider.terms(), Degree());
+        return apply(divider, dense, [](const Dense &a, const Dense &b) {
+            return a % b;
+        }, [](const Sparse &a, const Sparse &b) {
+            return a % b;
+        });
+    }
+
+    friend AdaptivePolynomial operator,(const AdaptivePolynomial& first, const AdaptivePolynomial& second) {
+        bool dense = prefer_dense(first.terms() + second.terms(), std::max(first.Degree(), second.Degree()));
+        return first.apply(second, dense, [](const Dense &a, const Dense &b) {
+            return (a, b);
+        }, [](const Sparse &a, const Sparse &b) {
+            return (a, b);
+        });
+    }
+
+    friend std::ostream& operator << (std::ostream& out, const AdaptivePolynomial& f) {
+        std::visit([&out](const auto &p) {
+            out << p;
+        }, f.data);
+        return out;
+    }
+};
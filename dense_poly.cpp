@@ -1,290 +1,3734 @@
+#pragma once
+
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <utility>
+#include <array>
+#include <tuple>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <atomic>
+#include <exception>
+
+#include "shared_vector.cpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POLYNOMIAL_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define POLYNOMIAL_VECTORIZE __attribute__((optimize("tree-vectorize")))
+#else
+#define POLYNOMIAL_VECTORIZE
+#endif
+
+namespace dense {
+
+template<uint32_t P>
+class ModInt {
+    static_assert(P > 1 && P < (1u << 31), "Modulus must fit into 31 bits");
+
+private:
+    uint32_t val;
+
+public:
+    static constexpr uint32_t modulus = P;
+
+    ModInt(long long x = 0) {
+        x %= static_cast<long long>(P);
+        val = static_cast<uint32_t>(x < 0 ? x + P : x);
+    }
+
+    uint32_t value() const {
+        return val;
+    }
+
+    ModInt power(unsigned long long n) const {
+        ModInt ans(1), base = *this;
+        while (n != 0) {
+            if (n & 1) {
+                ans *= base;
+            }
+            base *= base;
+            n >>= 1;
+        }
+        return ans;
+    }
+
+    ModInt inverse() const {
+        if (val == 0) {
+            throw std::invalid_argument("Division by zero");
+        }
+        return power(P - 2);
+    }
+
+    ModInt &operator+=(const ModInt &other) {
+        val += other.val;
+        if (val >= P) {
+            val -= P;
+        }
+        return *this;
+    }
+
+    ModInt &operator-=(const ModInt &other) {
+        val = val >= other.val ? val - other.val : val + P - other.val;
+        return *this;
+    }
+
+    ModInt &operator*=(const ModInt &other) {
+        val = static_cast<uint32_t>(static_cast<uint64_t>(val) * other.val % P);
+        return *this;
+    }
+
+    ModInt &operator/=(const ModInt &other) {
+        return *this *= other.inverse();
+    }
+
+    ModInt operator-() const {
+        ModInt ans;
+        ans.val = val == 0 ? 0 : P - val;
+        return ans;
+    }
+
+    friend ModInt operator+(ModInt first, const ModInt &second) {
+        return first += second;
+    }
+
+    friend ModInt operator-(ModInt first, const ModInt &second) {
+        return first -= second;
+    }
+
+    friend ModInt operator*(ModInt first, const ModInt &second) {
+        return first *= second;
+    }
+
+    friend ModInt operator/(ModInt first, const ModInt &second) {
+        return first /= second;
+    }
+
+    friend bool operator==(const ModInt &first, const ModInt &second) {
+        return first.val == second.val;
+    }
+
+    friend bool operator!=(const ModInt &first, const ModInt &second) {
+        return first.val != second.val;
+    }
+
+    friend bool operator<(const ModInt &first, const ModInt &second) {
+        return first.val < second.val;
+    }
+
+    friend bool operator>(const ModInt &first, const ModInt &second) {
+        return first.val > second.val;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const ModInt &x) {
+        return out << x.val;
+    }
+};
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping = false;
+
+    bool run_pending() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty()) {
+                return false;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+        return true;
+    }
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] {
+                    return stopping || !queue.empty();
+                });
+                if (queue.empty()) {
+                    return;
+                }
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+        for (size_t i = 1; i < threads; ++i) {
+            workers.emplace_back([this] {
+                work();
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    static ThreadPool &shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t size() const {
+        return workers.size() + 1;
+    }
+
+    template<typename Task>
+    void run(size_t count, Task task) {
+        if (workers.empty() || count <= 1) {
+            for (size_t i = 0; i != count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> pending(count - 1);
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto guarded = [&](size_t i) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        };
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 1; i != count; ++i) {
+                queue.emplace_back([&guarded, &pending, i] {
+                    guarded(i);
+                    pending.fetch_sub(1, std::memory_order_release);
+                });
+            }
+        }
+        ready.notify_all();
+
+        guarded(0);
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (!run_pending()) {
+                std::this_thread::yield();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    template<typename Task>
+    static void invoke(ThreadPool *pool, size_t count, Task task) {
+        if (pool != nullptr) {
+            pool->run(count, task);
+        } else {
+            for (size_t i = 0; i != count; ++i) {
+                task(i);
+            }
+        }
+    }
+
+    template<typename Body>
+    static void parallel_for(ThreadPool *pool, size_t count, Body body) {
+        size_t parts = pool != nullptr ? std::min(count, 4 * pool->size()) : 1;
+        invoke(pool, parts, [&](size_t k) {
+            body(count * k / parts, count * (k + 1) / parts);
+        });
+    }
+};
+
+}
+
+namespace dense::detail {
+
+template<typename T>
+struct is_mod_int : std::false_type {};
+
+template<uint32_t P>
+struct is_mod_int<ModInt<P>> : std::true_type {};
+
+template<typename T>
+struct is_wide_integer : std::bool_constant<std::numeric_limits<T>::is_integer &&
+                                            !std::numeric_limits<T>::is_bounded> {};
+
+template<typename T>
+struct is_field : std::bool_constant<!std::numeric_limits<T>::is_integer> {};
+
+template<uint32_t P>
+class NumberTheoreticTransform {
+private:
+    using Mint = ModInt<P>;
+
+    static Mint primitive_root() {
+        std::vector<uint32_t> factors;
+        uint32_t rest = P - 1;
+        for (uint32_t d = 2; d * d <= rest; ++d) {
+            if (rest % d == 0) {
+                factors.push_back(d);
+                while (rest % d == 0) {
+                    rest /= d;
+                }
+            }
+        }
+        if (rest > 1) {
+            factors.push_back(rest);
+        }
+
+        for (uint32_t g = 2;; ++g) {
+            bool ok = true;
+            for (uint32_t f : factors) {
+                if (Mint(g).power((P - 1) / f) == Mint(1)) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (ok) {
+                return Mint(g);
+            }
+        }
+    }
+
+    static std::shared_ptr<const std::vector<Mint>> roots(size_t n) {
+        static const Mint g = primitive_root();
+        static std::mutex mutex;
+        static std::shared_ptr<const std::vector<Mint>> cache =
+                std::make_shared<const std::vector<Mint>>(std::vector<Mint>{Mint(0), Mint(1)});
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cache->size() < n) {
+            std::vector<Mint> rt = *cache;
+            for (size_t k = rt.size(); k < n; k *= 2) {
+                rt.resize(2 * k);
+                Mint z = g.power((P - 1) / (2 * k));
+                for (size_t i = k / 2; i != k; ++i) {
+                    rt[2 * i] = rt[i];
+                    rt[2 * i + 1] = rt[i] * z;
+                }
+            }
+            cache = std::make_shared<const std::vector<Mint>>(std::move(rt));
+        }
+        return cache;
+    }
+
+public:
+    static size_t max_size() {
+        return (P - 1) & (0u - (P - 1));
+    }
+
+    template<typename Vector>
+    static void transform(Vector &a, bool invert, ThreadPool *pool = nullptr) {
+        size_t n = a.size();
+        ThreadPool::parallel_for(pool, n, [&a, n](size_t lo, size_t hi) {
+            size_t j = 0;
+            for (size_t bit = 1, rev = n >> 1; bit < n; bit <<= 1, rev >>= 1) {
+                if (lo & bit) {
+                    j |= rev;
+                }
+            }
+            for (size_t i = lo; i != hi; ++i) {
+                if (i < j) {
+                    std::swap(a[i], a[j]);
+                }
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1) {
+                    j ^= bit;
+                }
+                j ^= bit;
+            }
+        });
+
+        auto cache = roots(n);
+        const std::vector<Mint> &rt = *cache;
+        for (size_t len = 1; len < n; len *= 2) {
+            size_t blocks = n / (2 * len);
+            auto butterflies = [&](size_t i, size_t lo, size_t hi) {
+                for (size_t j = lo; j != hi; ++j) {
+                    Mint u = a[i + j], v = a[i + j + len] * rt[len + j];
+                    a[i + j] = u + v;
+                    a[i + j + len] = u - v;
+                }
+            };
+            if (blocks >= len) {
+                ThreadPool::parallel_for(pool, blocks, [&](size_t lo, size_t hi) {
+                    for (size_t block = lo; block != hi; ++block) {
+                        butterflies(2 * len * block, 0, len);
+                    }
+                });
+            } else {
+                ThreadPool::parallel_for(pool, len, [&](size_t lo, size_t hi) {
+                    for (size_t block = 0; block != blocks; ++block) {
+                        butterflies(2 * len * block, lo, hi);
+                    }
+                });
+            }
+        }
+
+        if (invert) {
+            std::reverse(a.begin() + 1, a.end());
+            Mint inv = Mint(static_cast<long long>(n)).inverse();
+            ThreadPool::parallel_for(pool, n, [&a, inv](size_t lo, size_t hi) {
+                for (size_t i = lo; i != hi; ++i) {
+                    a[i] *= inv;
+                }
+            });
+        }
+    }
+
+    template<typename Alloc = std::allocator<Mint>>
+    static void multiply(const Mint *a, size_t n, const Mint *b, size_t m, Mint *res, const Alloc &alloc = Alloc(),
+                         ThreadPool *pool = nullptr) {
+        size_t size = 1;
+        while (size < n + m - 1) {
+            size *= 2;
+        }
+
+        using Vector = std::vector<Mint, typename std::allocator_traits<Alloc>::template rebind_alloc<Mint>>;
+        Vector fa(a, a + n, alloc), fb(b, b + m, alloc);
+        fa.resize(size);
+        fb.resize(size);
+        ThreadPool::invoke(pool, 2, [&](size_t i) {
+            transform(i == 0 ? fa : fb, false, pool);
+        });
+        ThreadPool::parallel_for(pool, size, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                fa[i] *= fb[i];
+            }
+        });
+        transform(fa, true, pool);
+
+        ThreadPool::parallel_for(pool, n + m - 1, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                res[i] += fa[i];
+            }
+        });
+    }
+};
+
+class MultiModular {
+private:
+    static constexpr size_t prime_count = 91;
+
+    static constexpr std::array<uint32_t, prime_count> primes = {
+            2130706433, 2114977793, 2113929217, 2099249153, 2095054849, 2088763393,
+            2077229057, 2070937601, 2047868929, 2035286017, 2025848833, 2013265921,
+            1998585857, 1978662913, 1963982849, 1953497089, 1945108481, 1931476993,
+            1922039809, 1894776833, 1893728257, 1888485377, 1868562433, 1866465281,
+            1863319553, 1835008001, 1811939329, 1790967809, 1724907521, 1711276033,
+            1709178881, 1699741697, 1695547393, 1654652929, 1651507201, 1643118593,
+            1638924289, 1630535681, 1607467009, 1601175553, 1594884097, 1572864001,
+            1570766849, 1558183937, 1555038209, 1541406721, 1536163841, 1513095169,
+            1504706561, 1492123649, 1485832193, 1484783617, 1479540737, 1438646273,
+            1437597697, 1431306241, 1415577601, 1412431873, 1410334721, 1397751809,
+            1380974593, 1366294529, 1365245953, 1327497217, 1321205761, 1315962881,
+            1306525697, 1300234241, 1286602753, 1281359873, 1261436929, 1224736769,
+            1218445313, 1214251009, 1212153857, 1211105281, 1205862401, 1192230913,
+            1185939457, 1161822209, 1158676481, 1151336449, 1146093569, 1138753537,
+            1133510657, 1127219201, 1107296257, 1102053377, 1095761921, 1092616193,
+            1085276161
+    };
+
+    struct Field {
+        uint32_t p;
+        uint64_t reciprocal;
+
+        explicit Field(uint32_t p) : p(p), reciprocal(~uint64_t(0) / p) {
+        }
+
+        uint32_t reduce(uint64_t x) const {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 Wide;
+            uint64_t q = static_cast<uint64_t>((static_cast<Wide>(x) * reciprocal) >> 64);
+            uint64_t r = x - q * p;
+            return static_cast<uint32_t>(r >= p ? r - p : r);
+#else
+            return static_cast<uint32_t>(x % p);
+#endif
+        }
+
+        uint32_t mul(uint32_t a, uint32_t b) const {
+            return reduce(static_cast<uint64_t>(a) * b);
+        }
+
+        uint32_t add(uint32_t a, uint32_t b) const {
+            uint32_t r = a + b;
+            return r >= p ? r - p : r;
+        }
+
+        uint32_t sub(uint32_t a, uint32_t b) const {
+            return a >= b ? a - b : a + p - b;
+        }
+
+        uint32_t power(uint32_t x, uint64_t e) const {
+            uint32_t ans = 1;
+            for (; e != 0; e >>= 1, x = mul(x, x)) {
+                if (e & 1) {
+                    ans = mul(ans, x);
+                }
+            }
+            return ans;
+        }
+
+        uint32_t inverse(uint32_t x) const {
+            return power(x, p - 2);
+        }
+    };
+
+    static uint32_t primitive_root(const Field &f) {
+        std::vector<uint32_t> factors;
+        uint32_t rest = f.p - 1;
+        for (uint32_t d = 2; d * d <= rest; ++d) {
+            if (rest % d == 0) {
+                factors.push_back(d);
+                while (rest % d == 0) {
+                    rest /= d;
+                }
+            }
+        }
+        if (rest > 1) {
+            factors.push_back(rest);
+        }
+        for (uint32_t g = 2;; ++g) {
+            if (std::all_of(factors.begin(), factors.end(), [&](uint32_t q) {
+                return f.power(g, (f.p - 1) / q) != 1;
+            })) {
+                return g;
+            }
+        }
+    }
+
+    static const std::array<uint32_t, prime_count> &generators() {
+        static const std::array<uint32_t, prime_count> table = [] {
+            std::array<uint32_t, prime_count> ans{};
+            for (size_t t = 0; t != prime_count; ++t) {
+                ans[t] = primitive_root(Field(primes[t]));
+            }
+            return ans;
+        }();
+        return table;
+    }
+
+    template<typename Vector>
+    static void transform(Vector &a, const Field &f, const Vector &rt, bool invert) {
+        size_t n = a.size();
+        for (size_t i = 1, j = 0; i < n; ++i) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(a[i], a[j]);
+            }
+        }
+        for (size_t len = 1; len < n; len *= 2) {
+            for (size_t i = 0; i < n; i += 2 * len) {
+                for (size_t j = 0; j != len; ++j) {
+                    uint32_t u = a[i + j], v = f.mul(a[i + j + len], rt[len + j]);
+                    a[i + j] = f.add(u, v);
+                    a[i + j + len] = f.sub(u, v);
+                }
+            }
+        }
+        if (invert) {
+            std::reverse(a.begin() + 1, a.end());
+            uint32_t inv = f.inverse(static_cast<uint32_t>(n % f.p));
+            for (auto &x : a) {
+                x = f.mul(x, inv);
+            }
+        }
+    }
+
+    static const std::vector<uint32_t> &garner_inverses() {
+        static const std::vector<uint32_t> table = [] {
+            std::vector<uint32_t> ans(prime_count * prime_count);
+            for (size_t j = 0; j != prime_count; ++j) {
+                const Field f(primes[j]);
+                for (size_t i = 0; i != j; ++i) {
+                    ans[i * prime_count + j] = f.inverse(primes[i] % primes[j]);
+                }
+            }
+            return ans;
+        }();
+        return table;
+    }
+
+    template<typename Alloc>
+    static void residue_product(size_t t, const uint32_t *a, size_t n, const uint32_t *b, size_t m, uint32_t *res,
+                                const Alloc &alloc) {
+        using Vector = std::vector<uint32_t, typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t>>;
+        const Field f(primes[t]);
+        size_t size = 1;
+        while (size < n + m - 1) {
+            size *= 2;
+        }
+
+        Vector rt(std::max<size_t>(size, 2), alloc);
+        rt[1] = 1;
+        for (size_t k = 2; k < size; k *= 2) {
+            uint32_t z = f.power(generators()[t], (f.p - 1) / (2 * k));
+            for (size_t i = k / 2; i != k; ++i) {
+                rt[2 * i] = rt[i];
+                rt[2 * i + 1] = f.mul(rt[i], z);
+            }
+        }
+
+        Vector fa(a, a + n, alloc), fb(b, b + m, alloc);
+        fa.resize(size);
+        fb.resize(size);
+        transform(fa, f, rt, false);
+        transform(fb, f, rt, false);
+        for (size_t i = 0; i != size; ++i) {
+            fa[i] = f.mul(fa[i], fb[i]);
+        }
+        transform(fa, f, rt, true);
+        std::copy(fa.begin(), fa.begin() + (n + m - 1), res);
+    }
+
+    template<typename T>
+    static size_t bit_bound(const T &x) {
+        const T base = T(1 << 30);
+        size_t bits = 0;
+        for (T rest = x < T(0) ? -x : x; rest != T(0); rest /= base) {
+            bits += 30;
+        }
+        return bits;
+    }
+
+    template<typename T>
+    static size_t max_bits(const T *a, size_t n) {
+        T ans = T(0);
+        for (size_t i = 0; i != n; ++i) {
+            ans = std::max(ans, a[i] < T(0) ? T(-a[i]) : a[i]);
+        }
+        return bit_bound(ans);
+    }
+
+public:
+    static uint32_t prime(size_t i) {
+        return primes[i];
+    }
+
+    static size_t size() {
+        return prime_count;
+    }
+
+    static uint32_t inverse(uint32_t x, uint32_t p) {
+        return Field(p).inverse(x);
+    }
+
+    template<typename T>
+    static uint32_t reduce(const T &x, uint32_t p) {
+        long long r;
+        if constexpr (std::numeric_limits<T>::is_bounded && std::numeric_limits<T>::digits < 31) {
+            r = static_cast<long long>(x) % p;
+        } else {
+            r = static_cast<long long>(x % T(p));
+        }
+        return static_cast<uint32_t>(r < 0 ? r + p : r);
+    }
+
+    static std::vector<uint32_t> gcd(std::vector<uint32_t> a, std::vector<uint32_t> b, uint32_t p) {
+        const Field f(p);
+        auto trim = [](std::vector<uint32_t> &v) {
+            while (!v.empty() && v.back() == 0) {
+                v.pop_back();
+            }
+        };
+        trim(a);
+        trim(b);
+        while (!b.empty()) {
+            uint32_t inv = f.inverse(b.back());
+            for (size_t i = a.size(); i-- >= b.size();) {
+                uint32_t coef = f.mul(a[i], inv);
+                if (coef != 0) {
+                    size_t shift = i + 1 - b.size();
+                    for (size_t j = 0; j != b.size(); ++j) {
+                        a[shift + j] = f.sub(a[shift + j], f.mul(coef, b[j]));
+                    }
+                }
+            }
+            trim(a);
+            std::swap(a, b);
+        }
+        if (!a.empty()) {
+            uint32_t inv = f.inverse(a.back());
+            for (auto &x : a) {
+                x = f.mul(x, inv);
+            }
+        }
+        return a;
+    }
+
+    template<typename T, typename Alloc = std::allocator<T>>
+    static bool multiply(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc = Alloc(),
+                         ThreadPool *pool = nullptr, size_t length_per_prime = 0) {
+        if (std::min(n, m) < length_per_prime) {
+            return false;
+        }
+        size_t bits = max_bits(a, n) + max_bits(b, m) + bit_bound(T(std::min(n, m))) + 1;
+        size_t k = bits / 30 + 1;
+        if (k > prime_count || std::min(n, m) < length_per_prime * k || n + m - 1 > (size_t(1) << 20)) {
+            return false;
+        }
+
+        using Vector = std::vector<uint32_t, typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t>>;
+        Vector ra(k * n, alloc), rb(k * m, alloc), rr(k * (n + m - 1), alloc);
+        ThreadPool::parallel_for(pool, n + m, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                for (size_t t = 0; t != k; ++t) {
+                    if (i < n) {
+                        ra[t * n + i] = reduce(a[i], primes[t]);
+                    } else {
+                        rb[t * m + i - n] = reduce(b[i - n], primes[t]);
+                    }
+                }
+            }
+        });
+        ThreadPool::invoke(pool, k, [&](size_t t) {
+            residue_product(t, ra.data() + t * n, n, rb.data() + t * m, m, rr.data() + t * (n + m - 1), alloc);
+        });
+
+        const std::vector<uint32_t> &inv = garner_inverses();
+        T total = T(1);
+        for (size_t j = 0; j != k; ++j) {
+            total *= T(primes[j]);
+        }
+        const T half = total / T(2);
+
+        ThreadPool::parallel_for(pool, n + m - 1, [&](size_t lo, size_t hi) {
+            std::vector<Field> fields;
+            for (size_t j = 0; j != k; ++j) {
+                fields.emplace_back(primes[j]);
+            }
+            std::vector<uint32_t> digits(k);
+            for (size_t i = lo; i != hi; ++i) {
+                for (size_t j = 0; j != k; ++j) {
+                    const Field &f = fields[j];
+                    uint32_t x = rr[j * (n + m - 1) + i];
+                    for (size_t t = 0; t != j; ++t) {
+                        uint32_t d = digits[t] >= f.p ? digits[t] - f.p : digits[t];
+                        x = f.mul(f.sub(x, d), inv[t * prime_count + j]);
+                    }
+                    digits[j] = x;
+                }
+                T value = T(digits[k - 1]);
+                for (size_t j = k - 1; j-- != 0;) {
+                    value = value * T(primes[j]) + T(digits[j]);
+                }
+                if (value > half) {
+                    value -= total;
+                }
+                res[i] += value;
+            }
+        });
+        return true;
+    }
+};
+
+class FastFourierTransform {
+private:
+    using Complex = std::complex<double>;
+
+    static std::shared_ptr<const std::vector<Complex>> roots(size_t n) {
+        static std::mutex mutex;
+        static std::shared_ptr<const std::vector<Complex>> cache =
+                std::make_shared<const std::vector<Complex>>(std::vector<Complex>{Complex(0), Complex(1)});
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cache->size() < n) {
+            std::vector<Complex> rt = *cache;
+            const long double pi = std::acos(-1.0L);
+            for (size_t k = rt.size(); k < n; k *= 2) {
+                rt.resize(2 * k);
+                for (size_t i = k; i != 2 * k; ++i) {
+                    long double angle = pi * static_cast<long double>(i - k) / static_cast<long double>(k);
+                    rt[i] = Complex(static_cast<double>(std::cos(angle)), static_cast<double>(std::sin(angle)));
+                }
+            }
+            cache = std::make_shared<const std::vector<Complex>>(std::move(rt));
+        }
+        return cache;
+    }
+
+public:
+    template<typename Vector>
+    static void transform(Vector &a, ThreadPool *pool = nullptr) {
+        size_t n = a.size();
+        ThreadPool::parallel_for(pool, n, [&a, n](size_t lo, size_t hi) {
+            size_t j = 0;
+            for (size_t bit = 1, rev = n >> 1; bit < n; bit <<= 1, rev >>= 1) {
+                if (lo & bit) {
+                    j |= rev;
+                }
+            }
+            for (size_t i = lo; i != hi; ++i) {
+                if (i < j) {
+                    std::swap(a[i], a[j]);
+                }
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1) {
+                    j ^= bit;
+                }
+                j ^= bit;
+            }
+        });
+
+        auto cache = roots(n);
+        const std::vector<Complex> &rt = *cache;
+        for (size_t len = 1; len < n; len *= 2) {
+            size_t blocks = n / (2 * len);
+            auto butterflies = [&](size_t i, size_t lo, size_t hi) {
+                for (size_t j = lo; j != hi; ++j) {
+                    const Complex &x = a[i + j + len], &w = rt[len + j];
+                    Complex u = a[i + j];
+                    Complex v(x.real() * w.real() - x.imag() * w.imag(), x.real() * w.imag() + x.imag() * w.real());
+                    a[i + j] = u + v;
+                    a[i + j + len] = u - v;
+                }
+            };
+            if (blocks >= len) {
+                ThreadPool::parallel_for(pool, blocks, [&](size_t lo, size_t hi) {
+                    for (size_t block = lo; block != hi; ++block) {
+                        butterflies(2 * len * block, 0, len);
+                    }
+                });
+            } else {
+                ThreadPool::parallel_for(pool, len, [&](size_t lo, size_t hi) {
+                    for (size_t block = 0; block != blocks; ++block) {
+                        butterflies(2 * len * block, lo, hi);
+                    }
+                });
+            }
+        }
+    }
+
+    template<typename T, typename Alloc = std::allocator<T>>
+    static void multiply(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc = Alloc(),
+                         ThreadPool *pool = nullptr) {
+        size_t size = 1, log = 0;
+        while (size < n + m - 1) {
+            size *= 2;
+            ++log;
+        }
+
+        using Vector = std::vector<Complex, typename std::allocator_traits<Alloc>::template rebind_alloc<Complex>>;
+        Vector in(size, alloc), out(size, alloc);
+        double max_a = 0, max_b = 0;
+        for (size_t i = 0; i != n; ++i) {
+            in[i].real(static_cast<double>(a[i]));
+            max_a = std::max(max_a, std::abs(static_cast<double>(a[i])));
+        }
+        for (size_t i = 0; i != m; ++i) {
+            in[i].imag(static_cast<double>(b[i]));
+            max_b = std::max(max_b, std::abs(static_cast<double>(b[i])));
+        }
+
+        transform(in, pool);
+        ThreadPool::parallel_for(pool, size, [&in](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                const Complex &x = in[i];
+                in[i] = Complex(x.real() * x.real() - x.imag() * x.imag(), 2 * x.real() * x.imag());
+            }
+        });
+        ThreadPool::parallel_for(pool, size, [&in, &out, size](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                out[i] = in[(size - i) & (size - 1)] - std::conj(in[i]);
+            }
+        });
+        transform(out, pool);
+
+        double error = 4 * std::numeric_limits<double>::epsilon() * (log + 1) *
+                       max_a * max_b * static_cast<double>(std::min(n, m));
+        ThreadPool::parallel_for(pool, n + m - 1, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                double x = out[i].imag() / (4.0 * static_cast<double>(size));
+                if (std::abs(x) > error) {
+                    res[i] += static_cast<T>(x);
+                }
+            }
+        });
+    }
+};
+
+class EvaluationKernel {
+private:
+    enum class Level {
+        Scalar, Avx2, Avx512
+    };
+
+    static Level level() {
+#ifdef POLYNOMIAL_X86_DISPATCH
+        static const Level cached = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+                                    ? Level::Avx512
+                                    : __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+                                      ? Level::Avx2 : Level::Scalar;
+        return cached;
+#else
+        return Level::Scalar;
+#endif
+    }
+
+    template<typename T>
+    static void horner_scalar(const T *coef, size_t n, const T *x, T *out, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            T a0 = coef[n - 1], a1 = a0, a2 = a0, a3 = a0;
+            for (size_t j = n - 1; j-- != 0;) {
+                a0 = a0 * x[i] + coef[j];
+                a1 = a1 * x[i + 1] + coef[j];
+                a2 = a2 * x[i + 2] + coef[j];
+                a3 = a3 * x[i + 3] + coef[j];
+            }
+            out[i] = a0;
+            out[i + 1] = a1;
+            out[i + 2] = a2;
+            out[i + 3] = a3;
+        }
+        for (; i != count; ++i) {
+            T ans = coef[n - 1];
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = ans * x[i] + coef[j];
+            }
+            out[i] = ans;
+        }
+    }
+
+#ifdef POLYNOMIAL_X86_DISPATCH
+    __attribute__((target("avx2,fma")))
+    static size_t horner_avx2(const double *coef, size_t n, const double *x, double *out, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256d px = _mm256_loadu_pd(x + i);
+            __m256d ans = _mm256_set1_pd(coef[n - 1]);
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = _mm256_fmadd_pd(ans, px, _mm256_set1_pd(coef[j]));
+            }
+            _mm256_storeu_pd(out + i, ans);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2,fma")))
+    static size_t horner_avx2(const float *coef, size_t n, const float *x, float *out, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_loadu_ps(x + i);
+            __m256 ans = _mm256_set1_ps(coef[n - 1]);
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = _mm256_fmadd_ps(ans, px, _mm256_set1_ps(coef[j]));
+            }
+            _mm256_storeu_ps(out + i, ans);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f")))
+    static size_t horner_avx512(const double *coef, size_t n, const double *x, double *out, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m512d px = _mm512_loadu_pd(x + i);
+            __m512d ans = _mm512_set1_pd(coef[n - 1]);
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = _mm512_fmadd_pd(ans, px, _mm512_set1_pd(coef[j]));
+            }
+            _mm512_storeu_pd(out + i, ans);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f")))
+    static size_t horner_avx512(const float *coef, size_t n, const float *x, float *out, size_t count) {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m512 px = _mm512_loadu_ps(x + i);
+            __m512 ans = _mm512_set1_ps(coef[n - 1]);
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = _mm512_fmadd_ps(ans, px, _mm512_set1_ps(coef[j]));
+            }
+            _mm512_storeu_ps(out + i, ans);
+        }
+        return i;
+    }
+
+    template<typename T>
+    __attribute__((target("avx512f,avx512dq")))
+    static size_t horner_avx512_int64(const T *coef, size_t n, const T *x, T *out, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m512i px = _mm512_loadu_si512(static_cast<const void *>(x + i));
+            __m512i ans = _mm512_set1_epi64(static_cast<long long>(coef[n - 1]));
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = _mm512_add_epi64(_mm512_mullo_epi64(ans, px),
+                                       _mm512_set1_epi64(static_cast<long long>(coef[j])));
+            }
+            _mm512_storeu_si512(static_cast<void *>(out + i), ans);
+        }
+        return i;
+    }
+#endif
+
+public:
+    template<typename T>
+    static constexpr bool supported = std::is_same_v<T, double> || std::is_same_v<T, float> ||
+                                      (std::is_integral_v<T> && sizeof(T) == 8);
+
+    template<typename T>
+    static T split_horner(const T *coef, size_t n, const T &x) {
+        if (n < 8) {
+            T ans = coef[n - 1];
+            for (size_t j = n - 1; j-- != 0;) {
+                ans = ans * x + coef[j];
+            }
+            return ans;
+        }
+
+        T x2 = x * x, x4 = x2 * x2;
+        size_t top = (n - 1) / 4 * 4;
+        T q[4];
+        for (size_t r = 0; r != 4; ++r) {
+            q[r] = top + r < n ? coef[top + r] : T(0);
+        }
+        for (size_t j = top; j != 0;) {
+            j -= 4;
+            q[0] = q[0] * x4 + coef[j];
+            q[1] = q[1] * x4 + coef[j + 1];
+            q[2] = q[2] * x4 + coef[j + 2];
+            q[3] = q[3] * x4 + coef[j + 3];
+        }
+        return (q[0] + q[1] * x) + (q[2] + q[3] * x) * x2;
+    }
+
+    template<typename T>
+    static void horner(const T *coef, size_t n, const T *x, T *out, size_t count) {
+        if (n == 0) {
+            std::fill(out, out + count, T(0));
+            return;
+        }
+
+        size_t done = 0;
+#ifdef POLYNOMIAL_X86_DISPATCH
+        Level current = level();
+        if constexpr (std::is_floating_point_v<T>) {
+            if (current == Level::Avx512) {
+                done = horner_avx512(coef, n, x, out, count);
+            } else if (current == Level::Avx2) {
+                done = horner_avx2(coef, n, x, out, count);
+            }
+        } else {
+            if (current == Level::Avx512) {
+                done = horner_avx512_int64(coef, n, x, out, count);
+            }
+        }
+#endif
+        horner_scalar(coef, n, x + done, out + done, count - done);
+    }
+};
+
+template<typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallVector {
+private:
+    using Traits = std::allocator_traits<Alloc>;
+
+    Alloc alloc;
+    T *ptr;
+    size_t count = 0, cap = N;
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+
+    T *inline_data() {
+        return reinterpret_cast<T *>(buffer);
+    }
+
+    bool is_inline() const {
+        return ptr == reinterpret_cast<const T *>(buffer);
+    }
+
+    void release() {
+        clear();
+        if (!is_inline()) {
+            Traits::deallocate(alloc, ptr, cap);
+            ptr = inline_data();
+            cap = N;
+        }
+    }
+
+    void steal(SmallVector &other) {
+        if (other.is_inline()) {
+            for (size_t i = 0; i != other.count; ++i) {
+                Traits::construct(alloc, ptr + i, std::move(other.ptr[i]));
+            }
+            count = other.count;
+            other.clear();
+        } else {
+            ptr = other.ptr;
+            count = other.count;
+            cap = other.cap;
+            other.ptr = other.inline_data();
+            other.count = 0;
+            other.cap = N;
+        }
+    }
+
+    template<typename Iter>
+    using enable_if_iterator = typename std::iterator_traits<Iter>::iterator_category;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    explicit SmallVector(const Alloc &a = Alloc()) : alloc(a), ptr(inline_data()) {
+    }
+
+    explicit SmallVector(size_t n, const Alloc &a = Alloc()) : SmallVector(a) {
+        resize(n);
+    }
+
+    SmallVector(size_t n, const T &value, const Alloc &a = Alloc()) : SmallVector(a) {
+        resize(n, value);
+    }
+
+    template<typename Iter, typename = enable_if_iterator<Iter>>
+    SmallVector(Iter first, Iter last, const Alloc &a = Alloc()) : SmallVector(a) {
+        assign(first, last);
+    }
+
+    SmallVector(const SmallVector &other)
+            : SmallVector(other, Traits::select_on_container_copy_construction(other.alloc)) {
+    }
+
+    SmallVector(const SmallVector &other, const Alloc &a) : SmallVector(a) {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : alloc(std::move(other.alloc)), ptr(inline_data()) {
+        steal(other);
+    }
+
+    SmallVector(SmallVector &&other, const Alloc &a) : SmallVector(a) {
+        if (alloc == other.alloc) {
+            steal(other);
+        } else {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+    }
+
+    ~SmallVector() {
+        release();
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+                if (alloc != other.alloc) {
+                    release();
+                }
+                alloc = other.alloc;
+            }
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) {
+        if (this != &other) {
+            if constexpr (Traits::propagate_on_container_move_assignment::value) {
+                release();
+                alloc = std::move(other.alloc);
+                steal(other);
+            } else if (alloc == other.alloc) {
+                release();
+                steal(other);
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const {
+        return alloc;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    size_t capacity() const {
+        return cap;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    T *data() {
+        return ptr;
+    }
+
+    const T *data() const {
+        return ptr;
+    }
+
+    T &operator[](size_t i) {
+        return ptr[i];
+    }
+
+    const T &operator[](size_t i) const {
+        return ptr[i];
+    }
+
+    T &back() {
+        return ptr[count - 1];
+    }
+
+    const T &back() const {
+        return ptr[count - 1];
+    }
+
+    iterator begin() {
+        return ptr;
+    }
+
+    const_iterator begin() const {
+        return ptr;
+    }
+
+    iterator end() {
+        return ptr + count;
+    }
+
+    const_iterator end() const {
+        return ptr + count;
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    void reserve(size_t n) {
+        if (n <= cap) {
+            return;
+        }
+        T *fresh = Traits::allocate(alloc, n);
+        for (size_t i = 0; i != count; ++i) {
+            Traits::construct(alloc, fresh + i, std::move(ptr[i]));
+            Traits::destroy(alloc, ptr + i);
+        }
+        if (!is_inline()) {
+            Traits::deallocate(alloc, ptr, cap);
+        }
+        ptr = fresh;
+        cap = n;
+    }
+
+    void resize(size_t n) {
+        reserve(n);
+        for (; count < n; ++count) {
+            Traits::construct(alloc, ptr + count);
+        }
+        while (count > n) {
+            Traits::destroy(alloc, ptr + --count);
+        }
+    }
+
+    void resize(size_t n, const T &value) {
+        T copy = value;
+        reserve(n);
+        for (; count < n; ++count) {
+            Traits::construct(alloc, ptr + count, copy);
+        }
+        while (count > n) {
+            Traits::destroy(alloc, ptr + --count);
+        }
+    }
+
+    void clear() {
+        while (count != 0) {
+            Traits::destroy(alloc, ptr + --count);
+        }
+    }
+
+    void assign(size_t n, const T &value) {
+        clear();
+        resize(n, value);
+    }
+
+    template<typename Iter, typename = enable_if_iterator<Iter>>
+    void assign(Iter first, Iter last) {
+        clear();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, enable_if_iterator<Iter>>) {
+            reserve(std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        if (count == cap) {
+            T value(std::forward<Args>(args)...);
+            reserve(std::max<size_t>(1, 2 * cap));
+            Traits::construct(alloc, ptr + count, std::move(value));
+        } else {
+            Traits::construct(alloc, ptr + count, std::forward<Args>(args)...);
+        }
+        return ptr[count++];
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+};
+
+}
+
+namespace dense {
+
+template<typename T, typename Alloc = std::allocator<T>>
+class SubproductTree;
+
+template<typename T, typename Alloc = std::allocator<T>>
+class Modulus;
+
+template<typename T, typename Alloc = std::allocator<T>>
+class PolynomialBatch;
+
+template<typename T, typename Alloc = std::allocator<T>>
+class Polynomial;
+
+template<typename T, typename E>
+class PolynomialExpression {
+public:
+    using value_type = T;
+
+    const E &self() const {
+        return static_cast<const E &>(*this);
+    }
+
+    T operator[](size_t i) const {
+        return self().coefficient(i);
+    }
+
+    long long int Degree() const {
+        for (size_t i = self().size(); i-- != 0;) {
+            if (self().coefficient(i) != T(0)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    T operator ()(const T& scalar) const {
+        T ans = T(0);
+        for (size_t i = self().size(); i-- != 0;) {
+            ans = ans * scalar + self().coefficient(i);
+        }
+        return ans;
+    }
+
+    auto eval() const {
+        return typename E::polynomial_type(self());
+    }
+
+    auto power(long long int n) const {
+        return eval().power(n);
+    }
+};
+
+template<typename T, typename Alloc>
+class Polynomial {
+private:
+    friend class Modulus<T, Alloc>;
+    friend class PolynomialBatch<T, Alloc>;
+
+    template<typename U>
+    using Rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+    static constexpr size_t inline_capacity = 8;
+
+    static constexpr size_t share_threshold = 64;
+
+    using Vector = detail::SmallVector<T, inline_capacity, Rebind<T>>;
+
+    using Storage = polynomial::detail::SharedVector<Vector, share_threshold>;
+
+    Storage data;
+
+    template<typename E>
+    static Alloc expression_allocator(const E &e) {
+        if constexpr (std::is_same_v<typename E::polynomial_type, Polynomial>) {
+            return e.get_allocator();
+        } else {
+            return Alloc();
+        }
+    }
+
+    static void cut_vector(Vector &v) {
+        size_t size = v.size();
+        while (size != 0 && v[size - 1] == T(0)) {
+            --size;
+        }
+        v.resize(size);
+    }
+
+    static void cut_vector(Storage &v) {
+        size_t size = v.size();
+        while (size != 0 && v[size - 1] == T(0)) {
+            --size;
+        }
+        if (size != v.size()) {
+            v.resize(size);
+        }
+    }
+
+    static ThreadPool *pool_for(size_t size) {
+        if constexpr (!std::allocator_traits<Alloc>::is_always_equal::value) {
+            return nullptr;
+        } else if (size < parallel_threshold) {
+            return nullptr;
+        } else {
+            return thread_pool != nullptr ? thread_pool : &ThreadPool::shared();
+        }
+    }
+
+    static void mul_schoolbook(const T *a, size_t n, const T *b, size_t m, T *res) {
+        for (size_t i = 0; i != n; ++i) {
+            for (size_t j = 0; j != m; ++j) {
+                res[i + j] += a[i] * b[j];
+            }
+        }
+    }
+
+    static void mul_chunked(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc,
+                            ThreadPool *pool) {
+        if (pool == nullptr) {
+            for (size_t i = 0; i < n; i += m) {
+                mul_into(a + i, std::min(m, n - i), b, m, res + i, alloc);
+            }
+            return;
+        }
+        size_t chunks = (n + m - 1) / m;
+        for (size_t parity = 0; parity != 2; ++parity) {
+            ThreadPool::parallel_for(pool, (chunks + 1 - parity) / 2, [&](size_t lo, size_t hi) {
+                for (size_t c = lo; c != hi; ++c) {
+                    size_t i = (2 * c + parity) * m;
+                    mul_into(a + i, std::min(m, n - i), b, m, res + i, alloc);
+                }
+            });
+        }
+    }
+
+    static void mul_karatsuba(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc,
+                              ThreadPool *pool) {
+        size_t k = (n + 1) / 2;
+        Vector sa(a, a + k, alloc), sb(b, b + k, alloc);
+        for (size_t i = k; i != n; ++i) {
+            sa[i - k] += a[i];
+        }
+        for (size_t i = k; i != m; ++i) {
+            sb[i - k] += b[i];
+        }
+
+        Vector low(2 * k - 1, alloc), high(n + m - 2 * k - 1, alloc), mid(2 * k - 1, alloc);
+        ThreadPool::invoke(pool, 3, [&](size_t part) {
+            if (part == 0) {
+                mul_into(a, k, b, k, low.data(), alloc);
+            } else if (part == 1) {
+                mul_into(a + k, n - k, b + k, m - k, high.data(), alloc);
+            } else {
+                mul_into(sa.data(), k, sb.data(), k, mid.data(), alloc);
+            }
+        });
+
+        for (size_t i = 0; i != low.size(); ++i) {
+            res[i] += low[i];
+            mid[i] -= low[i];
+        }
+        for (size_t i = 0; i != high.size(); ++i) {
+            res[2 * k + i] += high[i];
+            mid[i] -= high[i];
+        }
+        for (size_t i = 0; i != mid.size(); ++i) {
+            res[k + i] += mid[i];
+        }
+    }
+
+    static void mul_toom3(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc, ThreadPool *pool) {
+        size_t k = (n + 2) / 3;
+        size_t w = 2 * k - 1;
+        auto evaluate = [k, &alloc](const T *p, size_t len) {
+            Vector v(5 * k, alloc);
+            for (size_t i = 0; i != k; ++i) {
+                T p0 = p[i];
+                T p1 = k + i < len ? p[k + i] : T(0);
+                T p2 = 2 * k + i < len ? p[2 * k + i] : T(0);
+                v[i] = p0;
+                v[k + i] = p0 + p1 + p2;
+                v[2 * k + i] = p0 - p1 + p2;
+                v[3 * k + i] = p0 - T(2) * p1 + T(4) * p2;
+                v[4 * k + i] = p2;
+            }
+            return v;
+        };
+
+        Vector pa = evaluate(a, n), pb = evaluate(b, m);
+        Vector r(5 * w, alloc);
+        ThreadPool::invoke(pool, 5, [&](size_t j) {
+            mul_into(pa.data() + j * k, k, pb.data() + j * k, k, r.data() + j * w, alloc);
+        });
+
+        for (size_t i = 0; i != w; ++i) {
+            T r0 = r[i], r4 = r[4 * w + i];
+            T r3 = (r[3 * w + i] - r[w + i]) / T(3);
+            T r1 = (r[w + i] - r[2 * w + i]) / T(2);
+            T r2 = r[2 * w + i] - r0;
+            r3 = (r2 - r3) / T(2) + T(2) * r4;
+            r2 += r1 - r4;
+            r1 -= r3;
+
+            T parts[5] = {r0, r1, r2, r3, r4};
+            for (size_t j = 0; j != 5; ++j) {
+                if (j * k + i < n + m - 1) {
+                    res[j * k + i] += parts[j];
+                }
+            }
+        }
+    }
+
+    static bool mul_three_prime(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc,
+                                ThreadPool *pool) {
+        constexpr uint32_t P1 = 998244353, P2 = 167772161, P3 = 469762049;
+        using M1 = ModInt<P1>;
+        using M2 = ModInt<P2>;
+        using M3 = ModInt<P3>;
+        const long double limit = 0x1p85L;
+
+        auto magnitude = [](const T *p, size_t len) {
+            unsigned long long ans = 0;
+            for (size_t i = 0; i != len; ++i) {
+                unsigned long long x = static_cast<unsigned long long>(p[i]);
+                if constexpr (std::is_signed_v<T>) {
+                    if (p[i] < T(0)) {
+                        x = 0 - x;
+                    }
+                }
+                ans = std::max(ans, x);
+            }
+            return ans;
+        };
+        unsigned long long max_a = magnitude(a, n), max_b = magnitude(b, m);
+        if (n + m - 1 > detail::NumberTheoreticTransform<P1>::max_size() ||
+                static_cast<long double>(max_a) * max_b * std::min(n, m) >= limit) {
+            return false;
+        }
+
+        auto residues = [&](auto tag) {
+            using Mint = decltype(tag);
+            std::vector<Mint, Rebind<Mint>> fa(n, alloc), fb(m, alloc), fr(n + m - 1, alloc);
+            for (size_t i = 0; i != n; ++i) {
+                fa[i] = Mint(static_cast<long long>(a[i]));
+            }
+            for (size_t i = 0; i != m; ++i) {
+                fb[i] = Mint(static_cast<long long>(b[i]));
+            }
+            detail::NumberTheoreticTransform<Mint::modulus>::multiply(fa.data(), n, fb.data(), m, fr.data(), alloc, pool);
+            return fr;
+        };
+        std::vector<M1, Rebind<M1>> r1(alloc);
+        std::vector<M2, Rebind<M2>> r2(alloc);
+        std::vector<M3, Rebind<M3>> r3(alloc);
+        ThreadPool::invoke(pool, 3, [&](size_t prime) {
+            if (prime == 0) {
+                r1 = residues(M1());
+            } else if (prime == 1) {
+                r2 = residues(M2());
+            } else {
+                r3 = residues(M3());
+            }
+        });
+
+        const M2 inv1 = M2(P1).inverse();
+        const M3 inv12 = (M3(P1) * M3(P2)).inverse();
+        const uint64_t total = static_cast<uint64_t>(P1) * P2 * P3;
+        ThreadPool::parallel_for(pool, n + m - 1, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i != hi; ++i) {
+                uint64_t x1 = r1[i].value();
+                uint64_t x2 = ((r2[i] - M2(x1)) * inv1).value();
+                uint64_t x3 = ((r3[i] - M3(x1) - M3(x2) * M3(P1)) * inv12).value();
+                uint64_t x = x1 + x2 * P1 + x3 * P1 * P2;
+                bool negative = x3 != P3 / 2 ? x3 > P3 / 2 : x2 != P2 / 2 ? x2 > P2 / 2 : x1 > P1 / 2;
+                if (negative) {
+                    x -= total;
+                }
+                res[i] += static_cast<T>(static_cast<long long>(x));
+            }
+        });
+        return true;
+    }
+
+    static void mul_into(const T *a, size_t n, const T *b, size_t m, T *res, const Alloc &alloc) {
+        if (n < m) {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+        if (m == 0) {
+            return;
+        }
+        ThreadPool *pool = pool_for(n + m - 1);
+        if constexpr (detail::is_mod_int<T>::value) {
+            using NTT = detail::NumberTheoreticTransform<T::modulus>;
+            if (m >= ntt_threshold && n + m - 1 <= NTT::max_size()) {
+                NTT::multiply(a, n, b, m, res, alloc, pool);
+                return;
+            }
+        } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            if (m >= fft_threshold) {
+                detail::FastFourierTransform::multiply(a, n, b, m, res, alloc, pool);
+                return;
+            }
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(long long)) {
+            if (m >= fft_threshold && mul_three_prime(a, n, b, m, res, alloc, pool)) {
+                return;
+            }
+        } else if constexpr (detail::is_wide_integer<T>::value) {
+            if (detail::MultiModular::multiply(a, n, b, m, res, alloc, pool, multi_modular_threshold)) {
+                return;
+            }
+        }
+        if (m < karatsuba_threshold) {
+            mul_schoolbook(a, n, b, m, res);
+        } else if (m <= (n + 1) / 2) {
+            mul_chunked(a, n, b, m, res, alloc, pool);
+        } else {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (m >= toom3_threshold && m > 2 * ((n + 2) / 3)) {
+                    mul_toom3(a, n, b, m, res, alloc, pool);
+                    return;
+                }
+            }
+            mul_karatsuba(a, n, b, m, res, alloc, pool);
+        }
+    }
+
+    static Vector multiply(const Vector &a, const Vector &b) {
+        if (a.empty() || b.empty()) {
+            return Vector(a.get_allocator());
+        }
+        Vector res(a.size() + b.size() - 1, a.get_allocator());
+        mul_into(a.data(), a.size(), b.data(), b.size(), res.data(), a.get_allocator());
+        return res;
+    }
+
+    static bool multiplies_by_transform(size_t m) {
+        if constexpr (detail::is_mod_int<T>::value) {
+            return m >= ntt_threshold;
+        } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float> ||
+                             (std::is_integral_v<T> && sizeof(T) <= sizeof(long long))) {
+            return m >= fft_threshold;
+        } else if constexpr (detail::is_wide_integer<T>::value) {
+            return m >= multi_modular_threshold;
+        } else {
+            return false;
+        }
+    }
+
+    static void mul_low_into(const T *a, size_t n, const T *b, size_t m, T *res, size_t k, const Alloc &alloc) {
+        n = std::min(n, k);
+        m = std::min(m, k);
+        if (n == 0 || m == 0) {
+            return;
+        }
+        if (n + m - 1 <= k) {
+            mul_into(a, n, b, m, res, alloc);
+        } else if (std::min(n, m) < karatsuba_threshold) {
+            for (size_t i = 0; i != n; ++i) {
+                for (size_t j = 0; j != m && i + j < k; ++j) {
+                    res[i + j] += a[i] * b[j];
+                }
+            }
+        } else if (multiplies_by_transform(std::min(n, m))) {
+            Vector full(n + m - 1, alloc);
+            mul_into(a, n, b, m, full.data(), alloc);
+            for (size_t i = 0; i != k; ++i) {
+                res[i] += full[i];
+            }
+        } else {
+            size_t h = k - k * 3 / 10, n0 = std::min(n, h), m0 = std::min(m, h);
+            Vector low(n0 + m0 - 1, alloc);
+            mul_into(a, n0, b, m0, low.data(), alloc);
+            for (size_t i = 0; i != std::min(k, low.size()); ++i) {
+                res[i] += low[i];
+            }
+            if (n > h) {
+                mul_low_into(a + h, n - h, b, m, res + h, k - h, alloc);
+            }
+            if (m > h) {
+                mul_low_into(a, n, b + h, m - h, res + h, k - h, alloc);
+            }
+        }
+    }
+
+    static Vector multiply_low(const Vector &a, const Vector &b, size_t k) {
+        size_t n = std::min(a.size(), k), m = std::min(b.size(), k);
+        if (n == 0 || m == 0) {
+            return Vector(a.get_allocator());
+        }
+        Vector res(std::min(k, n + m - 1), a.get_allocator());
+        mul_low_into(a.data(), n, b.data(), m, res.data(), res.size(), a.get_allocator());
+        return res;
+    }
+
+    static Vector inverse_prefix(const Vector &f, size_t k) {
+        Vector g(1, T(1) / f[0], f.get_allocator());
+        for (size_t len = 1; len < k;) {
+            len = std::min(2 * len, k);
+            Vector h = multiply_low(f, g, len);
+            h.resize(len);
+            for (auto &x : h) {
+                x = -x;
+            }
+            h[0] += T(2);
+            g = multiply_low(g, h, len);
+            g.resize(len);
+        }
+        return g;
+    }
+
+    static bool shift_by_convolution(size_t n) {
+        if constexpr (detail::is_mod_int<T>::value) {
+            return n >= shift_threshold && n < T::modulus;
+        } else {
+            return detail::is_field<T>::value && !std::is_floating_point_v<T> && n >= shift_threshold;
+        }
+    }
+
+    static std::array<Vector, 3> shift_tables(const T &a, size_t n, const Alloc &alloc) {
+        Vector fact(n, alloc), inv_fact(n, alloc), powers(n, alloc);
+        fact[0] = T(1);
+        for (size_t i = 1; i != n; ++i) {
+            fact[i] = fact[i - 1] * T(i);
+        }
+        inv_fact[n - 1] = T(1) / fact[n - 1];
+        for (size_t i = n - 1; i != 0; --i) {
+            inv_fact[i - 1] = inv_fact[i] * T(i);
+        }
+        T power = T(1);
+        for (size_t i = 0; i != n; ++i) {
+            powers[i] = power * inv_fact[i];
+            power *= a;
+        }
+        return {std::move(fact), std::move(inv_fact), std::move(powers)};
+    }
+
+    static void shift_convolution(Vector &p, const std::array<Vector, 3> &tables) {
+        const auto &[fact, inv_fact, powers] = tables;
+        size_t n = p.size();
+        Vector u(n, p.get_allocator());
+        for (size_t i = 0; i != n; ++i) {
+            u[n - 1 - i] = p[i] * fact[i];
+        }
+        Vector w = multiply_low(u, powers, n);
+        w.resize(n);
+        for (size_t k = 0; k != n; ++k) {
+            p[k] = w[n - 1 - k] * inv_fact[k];
+        }
+    }
+
+    static void shift_horner(Vector &p, const T &a) {
+        size_t n = p.size();
+        for (size_t k = 0; k + 1 < n; ++k) {
+            for (size_t j = n - 1; j-- != k;) {
+                p[j] += a * p[j + 1];
+            }
+        }
+    }
+
+    static Vector log_prefix(const Vector &f, size_t k) {
+        Vector ans(k, f.get_allocator());
+        if (k <= 1) {
+            return ans;
+        }
+        Vector derivative(std::min(f.size(), k) - 1, f.get_allocator());
+        for (size_t i = 1; i < std::min(f.size(), k); ++i) {
+            derivative[i - 1] = T(i) * f[i];
+        }
+        Vector q = multiply_low(derivative, inverse_prefix(f, k - 1), k - 1);
+        for (size_t i = 0; i != q.size(); ++i) {
+            ans[i + 1] = q[i] / T(i + 1);
+        }
+        return ans;
+    }
+
+    void divmod_classical(const Polynomial &divider, Vector &quotient, Vector &reminder) const {
+        size_t n = data.size(), m = divider.data.size();
+        const T &lead = divider.data.back();
+        reminder = data.get();
+        quotient.assign(n - m + 1, T(0));
+        for (size_t i = n - m + 1; i-- != 0;) {
+            T coef = reminder[i + m - 1] / lead;
+            quotient[i] = coef;
+            if (coef != T(0)) {
+                for (size_t j = 0; j + 1 < m; ++j) {
+                    reminder[i + j] -= coef * divider.data[j];
+                }
+                if constexpr (!detail::is_field<T>::value) {
+                    reminder[i + m - 1] -= coef * lead;
+                }
+            }
+        }
+        if constexpr (detail::is_field<T>::value) {
+            reminder.resize(m - 1);
+        }
+    }
+
+    void divmod_newton(const Polynomial &divider, Vector &quotient, Vector &reminder) const {
+        size_t n = data.size(), m = divider.data.size(), k = n - m + 1;
+        Vector ra(data.rbegin(), data.rbegin() + k, data.get_allocator());
+        Vector rb(divider.data.rbegin(), divider.data.rend(), data.get_allocator());
+
+        quotient = multiply_low(ra, inverse_prefix(rb, k), k);
+        quotient.resize(k);
+        std::reverse(quotient.begin(), quotient.end());
+
+        Vector product = multiply(quotient, divider.data.get());
+        reminder.assign(data.begin(), data.begin() + (m - 1));
+        for (size_t i = 0; i + 1 < m; ++i) {
+            reminder[i] -= product[i];
+        }
+    }
+
+    Polynomial compose(const Polynomial &other, const Polynomial *modulus) const {
+        auto reduce = [modulus](Polynomial p) {
+            if (modulus != nullptr) {
+                return p % *modulus;
+            }
+            return p;
+        };
+
+        size_t n = data.size(), k = 1;
+        if (n >= composition_threshold) {
+            while (k * k < n) {
+                ++k;
+            }
+        }
+
+        std::vector<Polynomial, Rebind<Polynomial>> baby(get_allocator());
+        baby.push_back(reduce(Polynomial(T(1), get_allocator())));
+        for (size_t i = 1; i <= k; ++i) {
+            baby.push_back(reduce(baby.back() * other));
+        }
+
+        Polynomial ans(get_allocator());
+        for (size_t block = (n + k - 1) / k; block-- != 0;) {
+            Vector acc(get_allocator());
+            for (size_t i = 0; i != k && block * k + i < n; ++i) {
+                const Vector &power = baby[i].data.get();
+                const T &coef = data[block * k + i];
+                acc.resize(std::max(acc.size(), power.size()));
+                for (size_t j = 0; j != power.size(); ++j) {
+                    acc[j] += coef * power[j];
+                }
+            }
+            ans = reduce(ans * baby[k]);
+            ans += Polynomial(std::move(acc));
+        }
+        return ans;
+    }
+
+    using Matrix = std::array<Polynomial, 4>;
+
+    static Matrix identity(const Alloc &alloc) {
+        return {Polynomial(T(1), alloc), Polynomial(alloc), Polynomial(alloc), Polynomial(T(1), alloc)};
+    }
+
+    static Matrix matrix_product(const Matrix &x, const Matrix &y) {
+        return {x[0] * y[0] + x[1] * y[2], x[0] * y[1] + x[1] * y[3],
+                x[2] * y[0] + x[3] * y[2], x[2] * y[1] + x[3] * y[3]};
+    }
+
+    static void apply(const Matrix &m, Polynomial &a, Polynomial &b) {
+        Polynomial c = m[0] * a + m[1] * b;
+        b = m[2] * a + m[3] * b;
+        a = std::move(c);
+    }
+
+    static void euclid_step(Polynomial &a, Polynomial &b, Matrix *m) {
+        auto [quotient, reminder] = a.divmod(b);
+        a = std::move(b);
+        b = std::move(reminder);
+        if (m != nullptr) {
+            Matrix &x = *m;
+            Polynomial c = x[0] - quotient * x[2], d = x[1] - quotient * x[3];
+            x[0] = std::move(x[2]);
+            x[1] = std::move(x[3]);
+            x[2] = std::move(c);
+            x[3] = std::move(d);
+        }
+    }
+
+    static Polynomial shift_down(const Polynomial &p, size_t k) {
+        if (p.data.size() <= k) {
+            return Polynomial(p.get_allocator());
+        }
+        return Polynomial(Vector(p.data.begin() + k, p.data.end(), p.data.get_allocator()));
+    }
+
+    static Matrix half_gcd(const Polynomial &a, const Polynomial &b) {
+        size_t m = (a.Degree() + 1) / 2;
+        if (b.Degree() < static_cast<long long>(m)) {
+            return identity(a.get_allocator());
+        }
+
+        Matrix r = half_gcd(shift_down(a, m), shift_down(b, m));
+        Polynomial c(a, a.get_allocator()), d(b, b.get_allocator());
+        apply(r, c, d);
+        if (d.Degree() < static_cast<long long>(m)) {
+            return r;
+        }
+
+        euclid_step(c, d, &r);
+        if (d.Degree() < static_cast<long long>(m)) {
+            return r;
+        }
+
+        size_t k = 2 * m - c.Degree();
+        return matrix_product(half_gcd(shift_down(c, k), shift_down(d, k)), r);
+    }
+
+    static T integer_gcd(T a, T b) {
+        a = a < T(0) ? T(-a) : a;
+        b = b < T(0) ? T(-b) : b;
+        while (b != T(0)) {
+            a %= b;
+            std::swap(a, b);
+        }
+        return a;
+    }
+
+    static T content(const Vector &v) {
+        T ans = T(0);
+        for (size_t i = 0; i != v.size() && ans != T(1); ++i) {
+            ans = integer_gcd(ans, v[i]);
+        }
+        return ans;
+    }
+
+    static bool divides_exactly(const Vector &divider, Vector r) {
+        size_t n = r.size(), m = divider.size();
+        if (n < m) {
+            return n == 0;
+        }
+        const T &lead = divider.back();
+        for (size_t i = n - m + 1; i-- != 0;) {
+            if (r[i + m - 1] % lead != T(0)) {
+                return false;
+            }
+            T coef = r[i + m - 1] / lead;
+            for (size_t j = 0; j != m; ++j) {
+                r[i + j] -= coef * divider[j];
+            }
+        }
+        return std::all_of(r.begin(), r.end(), [](const T &x) {
+            return x == T(0);
+        });
+    }
+
+    static Polynomial gcd_multi_modular(const Polynomial &first, const Polynomial &second) {
+        auto normalized = [](Vector v) {
+            if (!v.empty() && v.back() < T(0)) {
+                for (auto &x : v) {
+                    x = -x;
+                }
+            }
+            return Polynomial(std::move(v));
+        };
+        if (first.data.empty() || second.data.empty()) {
+            return normalized(first.data.empty() ? second.data.get() : first.data.get());
+        }
+
+        T ca = content(first.data.get()), cb = content(second.data.get()), c = integer_gcd(ca, cb);
+        Vector a(first.data.get(), first.get_allocator()), b(second.data.get(), first.get_allocator());
+        for (auto &x : a) {
+            x /= ca;
+        }
+        for (auto &x : b) {
+            x /= cb;
+        }
+        T lead = integer_gcd(a.back(), b.back());
+
+        Vector h(first.get_allocator());
+        T modulus = T(1);
+        size_t degree = std::numeric_limits<size_t>::max();
+        for (size_t t = 0; t != detail::MultiModular::size(); ++t) {
+            uint32_t p = detail::MultiModular::prime(t);
+            if (detail::MultiModular::reduce(a.back(), p) == 0 || detail::MultiModular::reduce(b.back(), p) == 0) {
+                continue;
+            }
+            std::vector<uint32_t> ra(a.size()), rb(b.size());
+            for (size_t i = 0; i != a.size(); ++i) {
+                ra[i] = detail::MultiModular::reduce(a[i], p);
+            }
+            for (size_t i = 0; i != b.size(); ++i) {
+                rb[i] = detail::MultiModular::reduce(b[i], p);
+            }
+            std::vector<uint32_t> g = detail::MultiModular::gcd(std::move(ra), std::move(rb), p);
+            if (g.size() == 1) {
+                return Polynomial(c, first.get_allocator());
+            }
+            if (g.size() > degree) {
+                continue;
+            }
+            uint64_t scale = detail::MultiModular::reduce(lead, p);
+            for (auto &x : g) {
+                x = static_cast<uint32_t>(x * scale % p);
+            }
+
+            bool changed = g.size() < degree;
+            if (changed) {
+                degree = g.size();
+                h.assign(degree, T(0));
+                modulus = T(1);
+            }
+            bool last = false;
+            if constexpr (std::numeric_limits<T>::is_bounded) {
+                const long double limit = static_cast<long double>(std::numeric_limits<T>::max());
+                if (static_cast<long double>(modulus) * p > limit) {
+                    break;
+                }
+                last = static_cast<long double>(modulus) * p * p > limit;
+            }
+            uint64_t inv = detail::MultiModular::inverse(detail::MultiModular::reduce(modulus, p), p);
+            T next = modulus * T(p), half = next / T(2);
+            for (size_t i = 0; i != degree; ++i) {
+                uint64_t u = (g[i] + p - detail::MultiModular::reduce(h[i], p)) % p * inv % p;
+                if (u != 0) {
+                    changed = true;
+                    h[i] += modulus * T(static_cast<long long>(u));
+                    if (h[i] > half) {
+                        h[i] -= next;
+                    }
+                }
+            }
+            modulus = next;
+
+            if (!changed || last) {
+                Vector candidate(h, h.get_allocator());
+                T ch = content(candidate);
+                for (auto &x : candidate) {
+                    x /= ch;
+                }
+                if (divides_exactly(candidate, a) && divides_exactly(candidate, b)) {
+                    for (auto &x : candidate) {
+                        x *= c;
+                    }
+                    return normalized(std::move(candidate));
+                }
+            }
+        }
+        throw std::invalid_argument("Coefficients are too large for multi-modular gcd");
+    }
+
+    static Polynomial gcd_engine(const Polynomial &first, const Polynomial &second, Matrix *m) {
+        Polynomial a(first, first.get_allocator()), b(second, first.get_allocator());
+        if (m != nullptr) {
+            *m = identity(first.get_allocator());
+        }
+        if (a.Degree() < b.Degree()) {
+            std::swap(a, b);
+            if (m != nullptr) {
+                std::swap((*m)[0], (*m)[2]);
+                std::swap((*m)[1], (*m)[3]);
+            }
+        }
+
+        while (!b.data.empty()) {
+            if (detail::is_field<T>::value && !std::is_floating_point_v<T> && a.Degree() > b.Degree() &&
+                    b.data.size() >= gcd_threshold) {
+                Matrix r = half_gcd(a, b);
+                apply(r, a, b);
+                if (m != nullptr) {
+                    *m = matrix_product(r, *m);
+                }
+                if (b.data.empty()) {
+                    break;
+                }
+            }
+            euclid_step(a, b, m);
+        }
+
+        if (!a.data.empty()) {
+            Polynomial lead(a.data.back(), a.get_allocator());
+            a = a / lead;
+            if (m != nullptr) {
+                (*m)[0] = (*m)[0] / lead;
+                (*m)[1] = (*m)[1] / lead;
+            }
+        }
+        return a;
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+
+    static inline size_t karatsuba_threshold = 32;
+    static inline size_t toom3_threshold = 256;
+    static inline size_t ntt_threshold = 64;
+    static inline size_t fft_threshold = 256;
+    static inline size_t division_threshold = 128;
+    static inline size_t gcd_threshold = 256;
+    static inline size_t composition_threshold = 16;
+    static inline size_t multipoint_threshold = 256;
+    static inline size_t shift_threshold = 32;
+    static inline size_t multi_modular_threshold = 32;
+    static inline size_t parallel_threshold = 1 << 16;
+    static inline ThreadPool *thread_pool = nullptr;
+
+    explicit Polynomial(const std::vector<T> &input, const Alloc &alloc = Alloc())
+            : data(Vector(input.begin(), input.end(), alloc)) {
+        cut_vector(data);
+    }
+
+    explicit Polynomial(Vector &&input) : data(std::move(input)) {
+        cut_vector(data);
+    }
+
+    explicit Polynomial(const T &scalar = T(), const Alloc &alloc = Alloc()) : data(alloc) {
+        if (scalar != T(0)) {
+            data.push_back(scalar);
+        }
+    }
+
+    explicit Polynomial(const Alloc &alloc) : data(alloc) {
+    }
+
+    template<typename Iter>
+    Polynomial(Iter first, Iter last, const Alloc &alloc = Alloc()) : data(alloc) {
+        for (auto it = first; it != last; ++it) {
+            data.push_back(*it);
+        }
+        cut_vector(data);
+    }
+
+    Polynomial(const Polynomial &other) = default;
+
+    Polynomial(Polynomial &&other) = default;
+
+    Polynomial(const Polynomial &other, const Alloc &alloc) : data(other.data, alloc) {
+    }
+
+    Polynomial(Polynomial &&other, const Alloc &alloc) : data(std::move(other.data), alloc) {
+    }
+
+    template<typename E>
+    Polynomial(const PolynomialExpression<T, E> &expr) : data(expression_allocator(expr.self())) {
+        *this = expr;
+    }
+
+    Polynomial &operator=(const Polynomial &other) = default;
+
+    Polynomial &operator=(Polynomial &&other) = default;
+
+    allocator_type get_allocator() const {
+        return data.get_allocator();
+    }
+
+    template<typename E>
+    Polynomial &operator=(const PolynomialExpression<T, E> &expr) {
+        const E &e = expr.self();
+        data.resize(e.size());
+        T *v = data.write();
+        for (size_t i = 0; i != data.size(); ++i) {
+            v[i] = e.coefficient(i);
+        }
+        cut_vector(data);
+        return *this;
+    }
+
+    bool operator==(const Polynomial &other) const {
+        if (data.size() != other.data.size()) {
+            return false;
+        } else {
+            for (size_t i = 0; i < data.size(); ++i) {
+                if (data[i] != other.data[i])
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    bool operator==(const T &scalar) const {
+        return *this == Polynomial(scalar);
+    }
+
+    friend bool operator==(const T &scalar, const Polynomial &expr) {
+        return expr == Polynomial(scalar);
+    }
+
+    bool operator!=(const Polynomial &other) const {
+        return !(*this == other);
+    }
+
+    bool operator!=(const T &scalar) const {
+        return !(*this == Polynomial(scalar));
+    }
+
+    friend bool operator!=(const T &scalar, const Polynomial &expr) {
+        return !(expr == Polynomial(scalar));
+    }
+
+    T operator[](size_t i) const {
+        if (i >= data.size()) {
+            return T(0);
+        } else {
+            return data[i];
+        }
+    }
+
+    long long int Degree() const {
+        if (data.empty()) {
+            return -1;
+        } else {
+            return data.size() - 1;
+        }
+    }
+
+    size_t capacity() const {
+        return data.capacity();
+    }
+
+    void reserve(size_t n) {
+        data.reserve(n);
+    }
+
+    const auto begin() const {
+        return data.begin();
+    }
+
+    const auto end() const {
+        return data.end();
+    }
+
+    Polynomial &operator+=(const Polynomial &other) {
+        data.resize(std::max(data.size(), other.data.size()));
+        T *v = data.write();
+        for (size_t i = 0; i != std::min(data.size(), other.data.size()); ++i) {
+            v[i] += other.data[i];
+        }
+        cut_vector(data);
+        return *this;
+    }
+
+    Polynomial &operator+=(const T &scalar) {
+        if (data.empty()) {
+            data.push_back(scalar);
+        } else {
+            data.write()[0] += scalar;
+        }
+        cut_vector(data);
+        return *this;
+    }
+
+
+    Polynomial &operator-=(const Polynomial &other) {
+        data.resize(std::max(data.size(), other.data.size()));
+        T *v = data.write();
+        for (size_t i = 0; i != std::min(data.size(), other.data.size()); ++i) {
+            v[i] -= other.data[i];
+        }
+        cut_vector(data);
+        return *this;
+    }
+
+    Polynomial &operator-=(const T &scalar) {
+        if (data.empty()) {
+            data.push_back(T(0));
+        }
+        data.write()[0] -= scalar;
+        cut_vector(data);
+        return *this;
+    }
+
+    template<typename E>
+    Polynomial &operator+=(const PolynomialExpression<T, E> &expr) {
+        const E &e = expr.self();
+        data.resize(std::max(data.size(), e.size()));
+        T *v = data.write();
+        for (size_t i = 0; i != e.size(); ++i) {
+            v[i] += e.coefficient(i);
+        }
+        cut_vector(data);
+        return *this;
+    }
+
+    template<typename E>
+    Polynomial &operator-=(const PolynomialExpression<T, E> &expr) {
+        const E &e = expr.self();
+        data.resize(std::max(data.size(), e.size()));
+        T *v = data.write();
+        for (size_t i = 0; i != e.size(); ++i) {
+            v[i] -= e.coefficient(i);
+        }
+        cut_vector(data);
+        return *this;
+    }
+
+    Polynomial &operator*=(const Polynomial &other) {
+        return *this = *this * other;
+    }
+
+    Polynomial &operator*=(const T &scalar) {
+        if (scalar == T(0)) {
+            data.clear();
+        } else {
+            T *v = data.write();
+            for (size_t i = 0; i != data.size(); ++i) {
+                v[i] *= scalar;
+            }
+        }
+        return *this;
+    }
+
+    Polynomial operator*(const Polynomial &other) const {
+        Polynomial ans(get_allocator());
+        if (!data.empty() && !other.data.empty()) {
+            ans.data.resize(data.size() + other.data.size() - 1);
+            mul_into(data.data(), data.size(), other.data.data(), other.data.size(), ans.data.write(),
+                     get_allocator());
+            cut_vector(ans.data);
+        }
+        return ans;
+    }
+
+    T operator ()(const T& scalar) const {
+        if (data.empty()) {
+            return T(0);
+        } else if constexpr (detail::EvaluationKernel::supported<T>) {
+            return detail::EvaluationKernel::split_horner(data.data(), data.size(), scalar);
+        } else {
+            T ans = data.back();
+            for (size_t i = data.size() - 1; i-- != 0;) {
+                ans = ans * scalar + data[i];
+            }
+            return ans;
+        }
+    }
+
+    Polynomial power(long long int n) const {
+        if (n < 0) {
+            throw std::invalid_argument("Negative exponent");
+        }
+        Polynomial ans(T(1), get_allocator());
+        Polynomial base(*this, get_allocator());
+        while (n != 0) {
+            if (n & 1) {
+                ans *= base;
+            }
+            n >>= 1;
+            if (n != 0) {
+                base *= base;
+            }
+        }
+        return ans;
+    }
+
+    Polynomial powmod(long long int n, const Polynomial& modulus) const {
+        if (n < 0) {
+            throw std::invalid_argument("Negative exponent");
+        }
+        Polynomial ans = Polynomial(T(1), get_allocator()) % modulus;
+        Polynomial base = *this % modulus;
+        while (n != 0) {
+            if (n & 1) {
+                ans = ans * base % modulus;
+            }
+            n >>= 1;
+            if (n != 0) {
+                base = base * base % modulus;
+            }
+        }
+        return ans;
+    }
+
+    Polynomial operator & (const Polynomial& other) const {
+        return compose(other, nullptr);
+    }
+
+    Polynomial compose_mod(const Polynomial& other, const Polynomial& modulus) const {
+        return compose(other, &modulus);
+    }
+
+    Polynomial shift(const T& a) const {
+        Vector ans(data.get(), get_allocator());
+        if (shift_by_convolution(ans.size())) {
+            shift_convolution(ans, shift_tables(a, ans.size(), get_allocator()));
+        } else {
+            shift_horner(ans, a);
+        }
+        return Polynomial(std::move(ans));
+    }
+
+    Polynomial mul_trunc(const Polynomial& other, size_t n) const {
+        return Polynomial(multiply_low(data.get(), other.data.get(), n));
+    }
+
+    Polynomial inverse_series(size_t n) const {
+        if (data.empty() || data[0] == T(0)) {
+            throw std::invalid_argument("Series is not invertible");
+        }
+        if constexpr (!detail::is_field<T>::value) {
+            if (data[0] != T(1) && data[0] != T(-1)) {
+                throw std::invalid_argument("Inverse requires constant term 1 or -1");
+            }
+        }
+        if (n == 0) {
+            return Polynomial(get_allocator());
+        }
+        return Polynomial(inverse_prefix(data.get(), n));
+    }
+
+    Polynomial log_series(size_t n) const {
+        static_assert(detail::is_field<T>::value, "Series logarithm requires field coefficients");
+        if (n == 0) {
+            return Polynomial(get_allocator());
+        }
+        if (data.empty() || data[0] != T(1)) {
+            throw std::invalid_argument("Logarithm requires constant term 1");
+        }
+        return Polynomial(log_prefix(data.get(), n));
+    }
+
+    Polynomial exp_series(size_t n) const {
+        static_assert(detail::is_field<T>::value, "Series exponent requires field coefficients");
+        if (!data.empty() && data[0] != T(0)) {
+            throw std::invalid_argument("Exponent requires constant term 0");
+        }
+        Vector g(1, T(1), get_allocator());
+        for (size_t len = 1; len < n;) {
+            len = std::min(2 * len, n);
+            Vector h = log_prefix(g, len);
+            for (size_t i = 0; i != len; ++i) {
+                h[i] = (i < data.size() ? data[i] : T(0)) - h[i];
+            }
+            h[0] += T(1);
+            g = multiply_low(g, h, len);
+        }
+        g.resize(n);
+        return Polynomial(std::move(g));
+    }
+
+    Polynomial sqrt_series(size_t n) const {
+        static_assert(detail::is_field<T>::value, "Series square root requires field coefficients");
+        if (data.empty()) {
+            return Polynomial(get_allocator());
+        }
+        T root = T(1);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (data[0] <= T(0)) {
+                throw std::invalid_argument("Square root requires a positive constant term");
+            }
+            root = std::sqrt(data[0]);
+        } else if (data[0] != T(1)) {
+            throw std::invalid_argument("Square root requires constant term 1");
+        }
+        Vector g(1, root, get_allocator());
+        const T half = T(1) / T(2);
+        for (size_t len = 1; len < n;) {
+            len = std::min(2 * len, n);
+            Vector q = multiply_low(data.get(), inverse_prefix(g, len), len);
+            g.resize(len);
+            for (size_t i = 0; i != q.size(); ++i) {
+                g[i] = (g[i] + q[i]) * half;
+            }
+            for (size_t i = q.size(); i != len; ++i) {
+                g[i] *= half;
+            }
+        }
+        g.resize(n);
+        return Polynomial(std::move(g));
+    }
+
+    std::vector<T> evaluate(const std::vector<T>& points) const {
+        if constexpr (detail::EvaluationKernel::supported<T>) {
+            if (std::is_floating_point_v<T> || data.size() < multipoint_threshold) {
+                std::vector<T> ans(points.size());
+                detail::EvaluationKernel::horner(data.data(), data.size(), points.data(), ans.data(), points.size());
+                return ans;
+            }
+        }
+        return SubproductTree<T, Alloc>(points, get_allocator()).evaluate(*this);
+    }
+
+    std::vector<T> evaluate(const SubproductTree<T, Alloc>& tree) const {
+        return tree.evaluate(*this);
+    }
+
+    static Polynomial interpolate(const std::vector<T>& xs, const std::vector<T>& ys, const Alloc &alloc = Alloc()) {
+        return SubproductTree<T, Alloc>(xs, alloc).interpolate(ys);
+    }
+
+    std::pair<Polynomial, Polynomial> divmod(const Polynomial& divider) const {
+        if (divider.Degree() == -1) {
+            throw std::invalid_argument("Division by zero");
+        } else if (Degree() < divider.Degree()) {
+            return {Polynomial(get_allocator()), Polynomial(*this, get_allocator())};
+        } else {
+            Vector quotient(get_allocator()), reminder(get_allocator());
+            size_t k = data.size() - divider.data.size() + 1;
+            if (detail::is_field<T>::value && std::min(k, divider.data.size()) >= division_threshold) {
+                divmod_newton(divider, quotient, reminder);
+            } else {
+                divmod_classical(divider, quotient, reminder);
+            }
+            return {Polynomial(std::move(quotient)), Polynomial(std::move(reminder))};
+        }
+    }
+
+    Polynomial operator / (const Polynomial& divider) const {
+        return divmod(divider).first;
+    }
+
+    Polynomial operator % (const Polynomial& divider) const {
+        return divmod(divider).second;
+    }
+
+    Polynomial operator % (const Modulus<T, Alloc>& modulus) const {
+        return modulus.reduce(*this);
+    }
+
+    friend Polynomial operator,(const Polynomial& first, const Polynomial& second) {
+        if constexpr (!detail::is_field<T>::value) {
+            return gcd_multi_modular(first, second);
+        } else {
+            return gcd_engine(first, second, nullptr);
+        }
+    }
+
+    friend std::tuple<Polynomial, Polynomial, Polynomial> extended_gcd(const Polynomial& first,
+                                                                       const Polynomial& second) {
+        static_assert(detail::is_field<T>::value, "Extended gcd requires field coefficients");
+        Matrix m = identity(first.get_allocator());
+        Polynomial ans = gcd_engine(first, second, &m);
+        return {std::move(ans), std::move(m[0]), std::move(m[1])};
+    }
+};
+
+template<typename X>
+struct ExpressionOperand {
+    using Stored = X;
+    using polynomial_type = typename X::polynomial_type;
+
+    static size_t size(const X &x) {
+        return x.size();
+    }
+
+    static auto coefficient(const X &x, size_t i) {
+        return x.coefficient(i);
+    }
+
+    static auto get_allocator(const X &x) {
+        return x.get_allocator();
+    }
+};
+
+template<typename T, typename Alloc>
+struct ExpressionOperand<Polynomial<T, Alloc>> {
+    using Stored = const Polynomial<T, Alloc> &;
+    using polynomial_type = Polynomial<T, Alloc>;
+
+    static size_t size(const Polynomial<T, Alloc> &p) {
+        return p.end() - p.begin();
+    }
+
+    static T coefficient(const Polynomial<T, Alloc> &p, size_t i) {
+        return i < size(p) ? p.begin()[i] : T(0);
+    }
+
+    static Alloc get_allocator(const Polynomial<T, Alloc> &p) {
+        return p.get_allocator();
+    }
+};
+
+template<typename L, typename R>
+using common_polynomial = std::conditional_t<std::is_void_v<typename ExpressionOperand<L>::polynomial_type>,
+                                             typename ExpressionOperand<R>::polynomial_type,
+                                             typename ExpressionOperand<L>::polynomial_type>;
+
+template<typename T>
+class ConstantExpression : public PolynomialExpression<T, ConstantExpression<T>> {
+private:
+    T value;
+
+public:
+    using polynomial_type = void;
+
+    explicit ConstantExpression(const T &scalar) : value(scalar) {
+    }
+
+    size_t size() const {
+        return value == T(0) ? 0 : 1;
+    }
+
+    T coefficient(size_t i) const {
+        return i == 0 ? value : T(0);
+    }
+};
+
+template<typename T, typename L, typename R, bool Subtract>
+class SumExpression : public PolynomialExpression<T, SumExpression<T, L, R, Subtract>> {
+private:
+    typename ExpressionOperand<L>::Stored left;
+    typename ExpressionOperand<R>::Stored right;
+
+public:
+    using polynomial_type = common_polynomial<L, R>;
+
+    SumExpression(const L &first, const R &second) : left(first), right(second) {
+    }
+
+    auto get_allocator() const {
+        if constexpr (std::is_void_v<typename ExpressionOperand<L>::polynomial_type>) {
+            return ExpressionOperand<R>::get_allocator(right);
+        } else {
+            return ExpressionOperand<L>::get_allocator(left);
+        }
+    }
+
+    size_t size() const {
+        return std::max(ExpressionOperand<L>::size(left), ExpressionOperand<R>::size(right));
+    }
+
+    T coefficient(size_t i) const {
+        T ans = ExpressionOperand<L>::coefficient(left, i);
+        if constexpr (Subtract) {
+            ans -= ExpressionOperand<R>::coefficient(right, i);
+        } else {
+            ans += ExpressionOperand<R>::coefficient(right, i);
+        }
+        return ans;
+    }
+};
+
+template<typename T, typename E>
+class ScaledExpression : public PolynomialExpression<T, ScaledExpression<T, E>> {
+private:
+    typename ExpressionOperand<E>::Stored expr;
+    T scalar;
+
+public:
+    using polynomial_type = typename ExpressionOperand<E>::polynomial_type;
+
+    ScaledExpression(const E &inner, const T &factor) : expr(inner), scalar(factor) {
+    }
+
+    auto get_allocator() const {
+        return ExpressionOperand<E>::get_allocator(expr);
+    }
+
+    size_t size() const {
+        return ExpressionOperand<E>::size(expr);
+    }
+
+    T coefficient(size_t i) const {
+        return ExpressionOperand<E>::coefficient(expr, i) * scalar;
+    }
+};
+
+template<typename X, typename = void>
+struct is_expression : std::false_type {};
+
+template<typename X>
+struct is_expression<X, std::void_t<typename X::value_type>>
+        : std::is_base_of<PolynomialExpression<typename X::value_type, X>, X> {};
+
+template<typename X, typename = void>
+struct is_operand : is_expression<X> {};
+
+template<typename T, typename Alloc>
+struct is_operand<Polynomial<T, Alloc>> : std::true_type {};
+
+template<typename L, typename R>
+using enable_if_operands = std::enable_if_t<is_operand<L>::value && is_operand<R>::value &&
+                                            std::is_same_v<typename L::value_type, typename R::value_type>>;
+
+template<typename L, typename R>
+using enable_if_lazy = std::enable_if_t<is_operand<L>::value && is_operand<R>::value &&
+                                        (is_expression<L>::value || is_expression<R>::value) &&
+                                        std::is_same_v<typename L::value_type, typename R::value_type>>;
+
+template<typename X>
+using enable_if_operand = std::enable_if_t<is_operand<X>::value>;
+
+template<typename X>
+using enable_if_expression = std::enable_if_t<is_expression<X>::value>;
+
+template<typename L, typename R, typename = enable_if_operands<L, R>>
+SumExpression<typename L::value_type, L, R, false> operator+(const L &first, const R &second) {
+    return {first, second};
+}
+
+template<typename L, typename R, typename = enable_if_operands<L, R>>
+SumExpression<typename L::value_type, L, R, true> operator-(const L &first, const R &second) {
+    return {first, second};
+}
+
+template<typename L, typename = enable_if_operand<L>>
+SumExpression<typename L::value_type, L, ConstantExpression<typename L::value_type>, false>
+operator+(const L &first, const typename L::value_type &scalar) {
+    return {first, ConstantExpression<typename L::value_type>(scalar)};
+}
+
+template<typename R, typename = enable_if_operand<R>>
+SumExpression<typename R::value_type, ConstantExpression<typename R::value_type>, R, false>
+operator+(const typename R::value_type &scalar, const R &second) {
+    return {ConstantExpression<typename R::value_type>(scalar), second};
+}
+
+template<typename L, typename = enable_if_operand<L>>
+SumExpression<typename L::value_type, L, ConstantExpression<typename L::value_type>, true>
+operator-(const L &first, const typename L::value_type &scalar) {
+    return {first, ConstantExpression<typename L::value_type>(scalar)};
+}
+
+template<typename R, typename = enable_if_operand<R>>
+SumExpression<typename R::value_type, ConstantExpression<typename R::value_type>, R, true>
+operator-(const typename R::value_type &scalar, const R &second) {
+    return {ConstantExpression<typename R::value_type>(scalar), second};
+}
+
+template<typename L, typename = enable_if_operand<L>>
+ScaledExpression<typename L::value_type, L> operator*(const L &first, const typename L::value_type &scalar) {
+    return {first, scalar};
+}
+
+template<typename R, typename = enable_if_operand<R>>
+ScaledExpression<typename R::value_type, R> operator*(const typename R::value_type &scalar, const R &second) {
+    return {second, scalar};
+}
+
+template<typename T, typename A, typename R, typename = enable_if_operands<Polynomial<T, A>, R>>
+Polynomial<T, A> operator+(Polynomial<T, A> &&first, const R &second) {
+    first += second;
+    return std::move(first);
+}
+
+template<typename L, typename T, typename A, typename = enable_if_expression<L>,
+         typename = enable_if_operands<L, Polynomial<T, A>>>
+Polynomial<T, A> operator+(const L &first, Polynomial<T, A> &&second) {
+    second += first;
+    return std::move(second);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator+(const Polynomial<T, A> &first, Polynomial<T, A> &&second) {
+    second += first;
+    return std::move(second);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator+(Polynomial<T, A> &&first, Polynomial<T, A> &&second) {
+    first += second;
+    return std::move(first);
+}
+
+template<typename T, typename A, typename R, typename = enable_if_operands<Polynomial<T, A>, R>>
+Polynomial<T, A> operator-(Polynomial<T, A> &&first, const R &second) {
+    first -= second;
+    return std::move(first);
+}
+
+template<typename L, typename T, typename A, typename = enable_if_expression<L>,
+         typename = enable_if_operands<L, Polynomial<T, A>>>
+Polynomial<T, A> operator-(const L &first, Polynomial<T, A> &&second) {
+    second *= T(0) - T(1);
+    second += first;
+    return std::move(second);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator-(const Polynomial<T, A> &first, Polynomial<T, A> &&second) {
+    second *= T(0) - T(1);
+    second += first;
+    return std::move(second);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator-(Polynomial<T, A> &&first, Polynomial<T, A> &&second) {
+    first -= second;
+    return std::move(first);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator+(Polynomial<T, A> &&first, const typename Polynomial<T, A>::value_type &scalar) {
+    first += scalar;
+    return std::move(first);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator+(const typename Polynomial<T, A>::value_type &scalar, Polynomial<T, A> &&second) {
+    second += scalar;
+    return std::move(second);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator-(Polynomial<T, A> &&first, const typename Polynomial<T, A>::value_type &scalar) {
+    first -= scalar;
+    return std::move(first);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator-(const typename Polynomial<T, A>::value_type &scalar, Polynomial<T, A> &&second) {
+    second *= T(0) - T(1);
+    second += scalar;
+    return std::move(second);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator*(Polynomial<T, A> &&first, const typename Polynomial<T, A>::value_type &scalar) {
+    first *= scalar;
+    return std::move(first);
+}
+
+template<typename T, typename A>
+Polynomial<T, A> operator*(const typename Polynomial<T, A>::value_type &scalar, Polynomial<T, A> &&second) {
+    second *= scalar;
+    return std::move(second);
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+common_polynomial<L, R> operator*(const L &first, const R &second) {
+    return common_polynomial<L, R>(first) * common_polynomial<L, R>(second);
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+common_polynomial<L, R> operator/(const L &first, const R &second) {
+    return common_polynomial<L, R>(first) / common_polynomial<L, R>(second);
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+common_polynomial<L, R> operator%(const L &first, const R &second) {
+    return common_polynomial<L, R>(first) % common_polynomial<L, R>(second);
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+common_polynomial<L, R> operator&(const L &first, const R &second) {
+    return common_polynomial<L, R>(first) & common_polynomial<L, R>(second);
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+common_polynomial<L, R> operator,(const L &first, const R &second) {
+    return (common_polynomial<L, R>(first), common_polynomial<L, R>(second));
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+bool operator==(const L &first, const R &second) {
+    return common_polynomial<L, R>(first) == common_polynomial<L, R>(second);
+}
+
+template<typename L, typename R, typename = enable_if_lazy<L, R>>
+bool operator!=(const L &first, const R &second) {
+    return !(first == second);
+}
+
+template<typename E, typename = enable_if_expression<E>>
+bool operator==(const E &expr, const typename E::value_type &scalar) {
+    return expr.eval() == scalar;
+}
+
+template<typename E, typename = enable_if_expression<E>>
+bool operator==(const typename E::value_type &scalar, const E &expr) {
+    return expr.eval() == scalar;
+}
+
+template<typename E, typename = enable_if_expression<E>>
+bool operator!=(const E &expr, const typename E::value_type &scalar) {
+    return !(expr == scalar);
+}
+
+template<typename E, typename = enable_if_expression<E>>
+bool operator!=(const typename E::value_type &scalar, const E &expr) {
+    return !(expr == scalar);
+}
+
+template<typename T, typename Alloc>
+class SubproductTree {
+private:
+    using Poly = Polynomial<T, Alloc>;
+
+    template<typename U>
+    using Rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+    std::vector<T, Rebind<T>> points;
+    std::vector<Poly, Rebind<Poly>> tree;
+
+    void build(size_t v, size_t l, size_t r) {
+        if (r - l == 1) {
+            const T leaf[] = {-points[l], T(1)};
+            tree[v] = Poly(std::begin(leaf), std::end(leaf), get_allocator());
+        } else {
+            size_t mid = (l + r) / 2;
+            build(2 * v, l, mid);
+            build(2 * v + 1, mid, r);
+            tree[v] = tree[2 * v] * tree[2 * v + 1];
+        }
+    }
+
+    void evaluate(size_t v, size_t l, size_t r, const Poly &p, std::vector<T> &ans) const {
+        if (r - l <= leaf_size) {
+            for (size_t i = l; i != r; ++i) {
+                ans[i] = p(points[i]);
+            }
+        } else {
+            size_t mid = (l + r) / 2;
+            evaluate(2 * v, l, mid, p % tree[2 * v], ans);
+            evaluate(2 * v + 1, mid, r, p % tree[2 * v + 1], ans);
+        }
+    }
+
+    Poly interpolate(size_t v, size_t l, size_t r, const std::vector<T> &weights) const {
+        if (r - l == 1) {
+            return Poly(weights[l], get_allocator());
+        } else {
+            size_t mid = (l + r) / 2;
+            return interpolate(2 * v, l, mid, weights) * tree[2 * v + 1] +
+                   interpolate(2 * v + 1, mid, r, weights) * tree[2 * v];
+        }
+    }
+
+public:
+    static inline size_t leaf_size = 32;
+
+    explicit SubproductTree(const std::vector<T> &input, const Alloc &alloc = Alloc())
+            : points(input.begin(), input.end(), alloc), tree(4 * input.size(), alloc) {
+        if (!points.empty()) {
+            build(1, 0, points.size());
+        }
+    }
+
+    Alloc get_allocator() const {
+        return points.get_allocator();
+    }
+
+    size_t size() const {
+        return points.size();
+    }
+
+    Poly root() const {
+        return points.empty() ? Poly(T(1), get_allocator()) : tree[1];
+    }
+
+    std::vector<T> evaluate(const Poly &p) const {
+        std::vector<T> ans(points.size());
+        if (!points.empty()) {
+            evaluate(1, 0, points.size(), p % tree[1], ans);
+        }
+        return ans;
+    }
+
+    Poly interpolate(const std::vector<T> &values) const {
+        if (values.size() != points.size()) {
+            throw std::invalid_argument("Number of values does not match number of points");
+        }
+        if (points.empty()) {
+            return Poly(get_allocator());
+        }
+
+        std::vector<T, Rebind<T>> derivative(get_allocator());
+        size_t i = 0;
+        for (auto it = tree[1].begin(); it != tree[1].end(); ++it, ++i) {
+            if (i != 0) {
+                derivative.push_back(T(i) * *it);
+            }
+        }
+
+        std::vector<T> weights = Poly(derivative.begin(), derivative.end(), get_allocator()).evaluate(*this);
+        for (size_t j = 0; j != weights.size(); ++j) {
+            weights[j] = values[j] / weights[j];
+        }
+        return interpolate(1, 0, points.size(), weights);
+    }
+};
+
+template<typename T, typename Alloc>
+class Modulus {
+private:
+    using Poly = Polynomial<T, Alloc>;
+    using Vector = typename Poly::Vector;
+
+    Poly f;
+    T lead_inverse;
+    Vector inverse;
+
+    bool use_barrett(size_t k) const {
+        return !inverse.empty() && k <= inverse.size();
+    }
+
+    Poly reduce_classical(const Vector &a) const {
+        size_t n = a.size(), m = f.data.size();
+        Vector r(a, a.get_allocator());
+        for (size_t i = n - m + 1; i-- != 0;) {
+            T coef = r[i + m - 1] * lead_inverse;
+            if (coef != T(0)) {
+                for (size_t j = 0; j + 1 < m; ++j) {
+                    r[i + j] -= coef * f.data[j];
+                }
+            }
+        }
+        r.resize(m - 1);
+        return Poly(std::move(r));
+    }
+
+    Poly reduce_barrett(const Vector &a) const {
+        size_t n = a.size(), m = f.data.size(), k = n - m + 1;
+        Vector ra(a.rbegin(), a.rbegin() + k, a.get_allocator());
+        Vector q = Poly::multiply_low(ra, inverse, k);
+        q.resize(k);
+        std::reverse(q.begin(), q.end());
+
+        Vector product(k + m - 1, a.get_allocator());
+        Poly::mul_into(q.data(), k, f.data.data(), m, product.data(), a.get_allocator());
+        Vector r(a.begin(), a.begin() + (m - 1), a.get_allocator());
+        for (size_t i = 0; i + 1 < m; ++i) {
+            r[i] -= product[i];
+        }
+        return Poly(std::move(r));
+    }
+
+public:
+    explicit Modulus(const Poly &modulus) : f(modulus, modulus.get_allocator()), lead_inverse(), inverse(modulus.get_allocator()) {
+        if (f.Degree() == -1) {
+            throw std::invalid_argument("Division by zero");
+        }
+        if constexpr (detail::is_field<T>::value) {
+            lead_inverse = T(1) / f.data.back();
+            size_t m = f.data.size();
+            if (m - 1 >= Poly::division_threshold) {
+                Vector rf(f.data.rbegin(), f.data.rend(), f.get_allocator());
+                inverse = Poly::inverse_prefix(rf, m - 1);
+            }
+        }
+    }
+
+    const Poly &polynomial() const {
+        return f;
+    }
+
+    long long int Degree() const {
+        return f.Degree();
+    }
+
+    Poly reduce(const Poly &p) const {
+        size_t n = p.data.size(), m = f.data.size();
+        if (n < m) {
+            return Poly(p, p.get_allocator());
+        }
+        if constexpr (!detail::is_field<T>::value) {
+            return p % f;
+        } else {
+            size_t k = n - m + 1;
+            if (use_barrett(k)) {
+                return reduce_barrett(p.data.get());
+            } else if (inverse.empty()) {
+                return reduce_classical(p.data.get());
+            } else {
+                return p % f;
+            }
+        }
+    }
+
+    Poly mulmod(const Poly &a, const Poly &b) const {
+        return reduce(a * b);
+    }
+
+    Poly sqrmod(const Poly &a) const {
+        return reduce(a * a);
+    }
+
+    Poly powmod(const Poly &a, long long int n) const {
+        if (n < 0) {
+            throw std::invalid_argument("Negative exponent");
+        }
+        Poly ans = reduce(Poly(T(1), a.get_allocator()));
+        Poly base = reduce(a);
+        while (n != 0) {
+            if (n & 1) {
+                ans = mulmod(ans, base);
+            }
+            n >>= 1;
+            if (n != 0) {
+                base = sqrmod(base);
+            }
+        }
+        return ans;
+    }
+};
+
+template<typename T, typename Alloc>
+class PolynomialBatch {
+private:
+    using Poly = Polynomial<T, Alloc>;
+
+    template<typename U>
+    using Rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+    using Vector = std::vector<T, Rebind<T>>;
+
+    size_t count = 0, rows = 0;
+    Vector data;
+
+    T *row(size_t i) {
+        return data.data() + i * count;
+    }
+
+    const T *row(size_t i) const {
+        return data.data() + i * count;
+    }
+
+    void widen(size_t n) {
+        if (n > rows) {
+            rows = n;
+            data.resize(rows * count, T(0));
+        }
+    }
+
+    void trim() {
+        while (rows != 0 && std::all_of(row(rows - 1), row(rows), [](const T &x) {
+            return x == T(0);
+        })) {
+            --rows;
+        }
+        data.resize(rows * count);
+    }
+
+    void check_size(const PolynomialBatch &other) const {
+        if (count != other.count) {
+            throw std::invalid_argument("Batch sizes do not match");
+        }
+    }
 
-template<typename T>
-class Polynomial {
-private:
-    std::vector<T> data;
+    POLYNOMIAL_VECTORIZE
+    static void add(T *__restrict dst, const T *__restrict src, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] += src[k];
+        }
+    }
 
-    void cut_vector(std::vector<T> &v) {
-        int pos = -1;
-        for (size_t i = v.size() - 1; i != size_t(-1); --i) {
-            if (v[i] != T(0)) {
-                pos = i;
-                break;
-            }
+    POLYNOMIAL_VECTORIZE
+    static void subtract(T *__restrict dst, const T *__restrict src, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] -= src[k];
         }
+    }
 
-        if (pos == -1)
-            v = {};
-        else
-            std::vector<T>(v.begin(), v.begin() + pos + 1).swap(v);
+    POLYNOMIAL_VECTORIZE
+    static void scale(T *__restrict dst, T scalar, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] *= scalar;
+        }
     }
 
-public:
-    explicit Polynomial(const std::vector<T> &input) {
-        data = input;
-        cut_vector(data);
+    POLYNOMIAL_VECTORIZE
+    static void add_scaled(T *__restrict dst, const T *__restrict src, T scalar, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] += scalar * src[k];
+        }
     }
 
-    explicit Polynomial(const T &scalar = T()) {
-        if (scalar == T(0)) {
-            data = {};
-        } else {
-            data = {scalar};
+    POLYNOMIAL_VECTORIZE
+    static void multiply_add(T *__restrict dst, const T *__restrict a, const T *__restrict b, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] += a[k] * b[k];
         }
     }
 
-    template<typename Iter>
-    Polynomial(Iter first, Iter last) {
-        for (auto it = first; it != last; ++it) {
-            data.push_back(*it);
+    POLYNOMIAL_VECTORIZE
+    static void multiply_subtract(T *__restrict dst, const T *__restrict a, const T *__restrict b, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] -= a[k] * b[k];
         }
-        cut_vector(data);
     }
 
-    bool operator==(const Polynomial &other) const {
-        if (data.size() != other.data.size()) {
-            return false;
-        } else {
-            for (size_t i = 0; i < data.size(); ++i) {
-                if (data[i] != other.data[i])
-                    return false;
+    POLYNOMIAL_VECTORIZE
+    static void divide(T *__restrict dst, const T *__restrict a, const T *__restrict b, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            dst[k] = a[k] / b[k];
+        }
+    }
+
+    POLYNOMIAL_VECTORIZE
+    static void horner_step(T *__restrict acc, const T *__restrict x, const T *__restrict coef, size_t n) {
+        for (size_t k = 0; k != n; ++k) {
+            acc[k] = acc[k] * x[k] + coef[k];
+        }
+    }
+
+    std::pair<PolynomialBatch, PolynomialBatch> divmod_columns(const PolynomialBatch &divider) const {
+        PolynomialBatch quotient(count, get_allocator()), reminder(count, get_allocator());
+        for (size_t j = 0; j != count; ++j) {
+            auto [q, r] = (*this)[j].divmod(divider[j]);
+            quotient.set(j, q);
+            reminder.set(j, r);
+        }
+        return {std::move(quotient), std::move(reminder)};
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+
+    static inline size_t block_size = 256;
+
+    explicit PolynomialBatch(size_t count = 0, const Alloc &alloc = Alloc()) : count(count), data(alloc) {
+    }
+
+    template<typename Iter, typename = typename std::iterator_traits<Iter>::iterator_category>
+    PolynomialBatch(Iter first, Iter last, const Alloc &alloc = Alloc())
+            : count(std::distance(first, last)), data(alloc) {
+        for (Iter it = first; it != last; ++it) {
+            rows = std::max(rows, static_cast<size_t>(it->Degree() + 1));
+        }
+        data.assign(rows * count, T(0));
+        size_t j = 0;
+        for (Iter it = first; it != last; ++it, ++j) {
+            size_t i = 0;
+            for (auto c = it->begin(); c != it->end(); ++c, ++i) {
+                data[i * count + j] = *c;
             }
-            return true;
         }
     }
 
-    bool operator==(const T &scalar) const {
-        return *this == Polynomial(scalar);
+    explicit PolynomialBatch(const std::vector<Poly> &polynomials, const Alloc &alloc = Alloc())
+            : PolynomialBatch(polynomials.begin(), polynomials.end(), alloc) {
     }
 
-    friend bool operator==(const T &scalar, const Polynomial &expr) {
-        return expr == Polynomial(scalar);
+    Alloc get_allocator() const {
+        return data.get_allocator();
     }
 
-    bool operator!=(const Polynomial &other) const {
-        return !(*this == other);
+    size_t size() const {
+        return count;
     }
 
-    bool operator!=(const T &scalar) const {
-        return !(*this == Polynomial(scalar));
+    long long int Degree() const {
+        return static_cast<long long int>(rows) - 1;
     }
 
-    friend bool operator!=(const T &scalar, const Polynomial &expr) {
-        return !(expr == Polynomial(scalar));
+    const T *coefficients(size_t i) const {
+        return row(i);
     }
 
-    T operator[](size_t i) const {
-        if (i > data.size() - 1) {
-            return T(0);
-        } else {
-            return data[i];
+    Poly operator[](size_t j) const {
+        Vector column(rows, get_allocator());
+        for (size_t i = 0; i != rows; ++i) {
+            column[i] = data[i * count + j];
         }
+        return Poly(column.begin(), column.end(), get_allocator());
     }
 
-    long long int Degree() const {
-        if (data.empty()) {
-            return -1;
-        } else {
-            return data.size() - 1;
+    void set(size_t j, const Poly &p) {
+        widen(p.Degree() + 1);
+        for (size_t i = 0; i != rows; ++i) {
+            data[i * count + j] = p[i];
         }
+        trim();
     }
 
-    const auto begin() const {
-        return data.begin();
+    std::vector<Poly> split() const {
+        std::vector<Poly> ans;
+        ans.reserve(count);
+        for (size_t j = 0; j != count; ++j) {
+            ans.push_back((*this)[j]);
+        }
+        return ans;
     }
 
-    const auto end() const {
-        return data.end();
+    bool operator==(const PolynomialBatch &other) const {
+        return count == other.count && rows == other.rows && data == other.data;
     }
 
-    Polynomial &operator+=(const Polynomial &other) {
-        data.resize(std::max(data.size(), other.data.size()));
-        for (size_t i = 0; i != std::min(data.size(), other.data.size()); ++i) {
-            data[i] += other.data[i];
+    bool operator!=(const PolynomialBatch &other) const {
+        return !(*this == other);
+    }
+
+    PolynomialBatch &operator+=(const PolynomialBatch &other) {
+        check_size(other);
+        if (this == &other) {
+            return *this += PolynomialBatch(other);
         }
-        cut_vector(data);
+        widen(other.rows);
+        add(data.data(), other.data.data(), other.data.size());
+        trim();
         return *this;
     }
 
-    Polynomial &operator+=(const T &scalar) {
-        return *this += Polynomial(scalar);
+    PolynomialBatch &operator-=(const PolynomialBatch &other) {
+        check_size(other);
+        if (this == &other) {
+            return *this = PolynomialBatch(count, get_allocator());
+        }
+        widen(other.rows);
+        subtract(data.data(), other.data.data(), other.data.size());
+        trim();
+        return *this;
     }
 
-
-    Polynomial &operator-=(const Polynomial &other) {
-        data.resize(std::max(data.size(), other.data.size()));
-        for (size_t i = 0; i != std::min(data.size(), other.data.size()); ++i) {
-            data[i] -= other.data[i];
-        }
-        cut_vector(data);
+    PolynomialBatch &operator*=(const T &scalar) {
+        scale(data.data(), scalar, data.size());
+        trim();
         return *this;
     }
 
-    Polynomial &operator-=(const T &scalar) {
-        return *this -= Polynomial(scalar);
+    PolynomialBatch &operator*=(const PolynomialBatch &other) {
+        return *this = *this * other;
+    }
+
+    PolynomialBatch operator+(const PolynomialBatch &other) const {
+        PolynomialBatch ans(*this);
+        ans += other;
+        return ans;
     }
 
-    Polynomial operator+(const Polynomial &other) const {
-        Polynomial temp = *this;
-        temp += other;
-        return temp;
+    PolynomialBatch operator-(const PolynomialBatch &other) const {
+        PolynomialBatch ans(*this);
+        ans -= other;
+        return ans;
     }
 
-    Polynomial operator+(const T &scalar) const {
-        return *this + Polynomial(scalar);
+    PolynomialBatch operator*(const T &scalar) const {
+        PolynomialBatch ans(*this);
+        ans *= scalar;
+        return ans;
     }
 
-    friend Polynomial operator+(const T &scalar, const Polynomial &expr) {
-        return Polynomial(scalar) + expr;
+    friend PolynomialBatch operator*(const T &scalar, const PolynomialBatch &batch) {
+        return batch * scalar;
     }
 
-    Polynomial operator-(const Polynomial &other) const {
-        Polynomial temp = *this;
-        temp -= other;
-        return temp;
+    PolynomialBatch operator*(const PolynomialBatch &other) const {
+        check_size(other);
+        if (rows == 0 || other.rows == 0) {
+            return PolynomialBatch(count, get_allocator());
+        }
+        PolynomialBatch ans(count, get_allocator());
+        ans.widen(rows + other.rows - 1);
+        for (size_t lo = 0; lo < count; lo += block_size) {
+            size_t width = std::min(block_size, count - lo);
+            for (size_t i = 0; i != rows; ++i) {
+                for (size_t j = 0; j != other.rows; ++j) {
+                    multiply_add(ans.row(i + j) + lo, row(i) + lo, other.row(j) + lo, width);
+                }
+            }
+        }
+        ans.trim();
+        return ans;
     }
 
-    Polynomial operator-(const T &scalar) const {
-        return *this - Polynomial(scalar);
+    std::vector<T> operator()(const std::vector<T> &points) const {
+        if (points.size() != count) {
+            throw std::invalid_argument("Number of points does not match batch size");
+        }
+        std::vector<T> ans(count, T(0));
+        for (size_t lo = 0; lo < count; lo += block_size) {
+            size_t width = std::min(block_size, count - lo);
+            for (size_t i = rows; i-- != 0;) {
+                horner_step(ans.data() + lo, points.data() + lo, row(i) + lo, width);
+            }
+        }
+        return ans;
     }
 
-    friend Polynomial operator-(const T &scalar, const Polynomial &expr) {
-        return Polynomial(scalar) - expr;
+    std::vector<T> operator()(const T &scalar) const {
+        return (*this)(std::vector<T>(count, scalar));
     }
 
-    Polynomial &operator*=(const Polynomial &other) {
-        if (data.empty() || other.data.empty()) {
-            *this = Polynomial();
-        } else {
-            std::vector<T> temp(data.size() + other.data.size() - 1);
-            for (size_t i = 0; i != data.size(); ++i) {
-                for (size_t j = 0; j != other.data.size(); ++j) {
-                    temp[i + j] += (data[i] * other.data[j]);
+    std::pair<PolynomialBatch, PolynomialBatch> divmod(const PolynomialBatch &divider) const {
+        check_size(divider);
+        size_t m = divider.rows;
+        for (size_t j = 0; j != count; ++j) {
+            if (divider[j].Degree() == -1) {
+                throw std::invalid_argument("Division by zero");
+            }
+        }
+        if (count == 0) {
+            return {PolynomialBatch(count, get_allocator()), PolynomialBatch(*this)};
+        }
+        const T *lead = divider.row(m - 1);
+        if (std::any_of(lead, lead + count, [](const T &x) {
+            return x == T(0);
+        })) {
+            return divmod_columns(divider);
+        }
+        if (rows < m) {
+            return {PolynomialBatch(count, get_allocator()), PolynomialBatch(*this)};
+        }
+
+        size_t n = rows;
+        PolynomialBatch quotient(count, get_allocator()), reminder(*this);
+        quotient.widen(n - m + 1);
+        for (size_t lo = 0; lo < count; lo += block_size) {
+            size_t width = std::min(block_size, count - lo);
+            for (size_t i = n - m + 1; i-- != 0;) {
+                T *coef = quotient.row(i) + lo;
+                divide(coef, reminder.row(i + m - 1) + lo, lead + lo, width);
+                for (size_t j = 0; j + 1 < m; ++j) {
+                    multiply_subtract(reminder.row(i + j) + lo, coef, divider.row(j) + lo, width);
+                }
+                if constexpr (!detail::is_field<T>::value) {
+                    multiply_subtract(reminder.row(i + m - 1) + lo, coef, lead + lo, width);
                 }
             }
-            *this = Polynomial(temp);
         }
-        return *this;
+        if constexpr (detail::is_field<T>::value) {
+            reminder.rows = m - 1;
+        }
+        quotient.trim();
+        reminder.trim();
+        return {std::move(quotient), std::move(reminder)};
     }
 
-    Polynomial &operator*=(const T &scalar) {
-        if (scalar == T(0)) {
-            *this = Polynomial();
+    PolynomialBatch shift(const T &a) const {
+        PolynomialBatch ans(*this);
+        if (Poly::shift_by_convolution(rows)) {
+            auto tables = Poly::shift_tables(a, rows, get_allocator());
+            typename Poly::Vector column(rows, get_allocator());
+            for (size_t j = 0; j != count; ++j) {
+                for (size_t i = 0; i != rows; ++i) {
+                    column[i] = data[i * count + j];
+                }
+                Poly::shift_convolution(column, tables);
+                for (size_t i = 0; i != rows; ++i) {
+                    ans.data[i * count + j] = column[i];
+                }
+            }
         } else {
-            for (size_t i = 0; i != data.size(); ++i) {
-                data[i] *= scalar;
+            for (size_t lo = 0; lo < count; lo += block_size) {
+                size_t width = std::min(block_size, count - lo);
+                for (size_t k = 0; k + 1 < rows; ++k) {
+                    for (size_t i = rows - 1; i-- != k;) {
+                        add_scaled(ans.row(i) + lo, ans.row(i + 1) + lo, a, width);
+                    }
+                }
             }
         }
-        return *this;
+        ans.trim();
+        return ans;
     }
 
-    Polynomial operator*(const Polynomial &other) const {
-        Polynomial<T> temp = *this;
-        temp *= other;
-        return temp;
+    PolynomialBatch operator/(const PolynomialBatch &divider) const {
+        return divmod(divider).first;
     }
 
-    Polynomial operator*(const T &scalar) const {
-        Polynomial<T> temp = *this;
-        temp *= scalar;
-        return temp;
+    PolynomialBatch operator%(const PolynomialBatch &divider) const {
+        return divmod(divider).second;
     }
+};
+
+template<typename T, size_t N>
+class FixedPolynomial {
+private:
+    std::array<T, N + 1> data;
+
+    template<typename, size_t>
+    friend class FixedPolynomial;
 
-    friend Polynomial operator*(const T &scalar, const Polynomial &other) {
-        Polynomial<T> temp = other;
-        temp *= scalar;
-        return temp;
+    template<size_t... I>
+    constexpr T horner(const T &x, std::index_sequence<I...>) const {
+        T ans = data[N];
+        ((ans = ans * x + data[N - 1 - I]), ...);
+        return ans;
     }
 
-    T operator ()(const T& scalar) const {
-        if (data.empty()) {
-            return T(0);
-        } else {
-            T ans = data[0];
-            T temp = scalar;
-            for (size_t i = 1; i < data.size(); ++i) {
-                ans += temp * data[i];
-                temp *= scalar;
-            }
-            return ans;
+public:
+    using value_type = T;
+
+    static constexpr size_t max_degree = N;
+
+    constexpr FixedPolynomial() : data{} {
+    }
+
+    template<typename... Args, typename = std::enable_if_t<(sizeof...(Args) >= 1 && sizeof...(Args) <= N + 1 &&
+                                                            (std::is_convertible_v<const Args &, T> && ...))>>
+    constexpr explicit FixedPolynomial(const Args &... coefficients) : data{T(coefficients)...} {
+    }
+
+    constexpr explicit FixedPolynomial(const std::array<T, N + 1> &coefficients) : data(coefficients) {
+    }
+
+    template<size_t M, typename = std::enable_if_t<(M < N)>>
+    constexpr FixedPolynomial(const FixedPolynomial<T, M> &other) : data{} {
+        for (size_t i = 0; i <= M; ++i) {
+            data[i] = other.data[i];
         }
     }
 
-    Polynomial power(long long int n) const {
-        Polynomial ans = *this;
-        for (long long int i = 1; i < n; ++i) {
-            ans *= *this;
+    template<typename Alloc>
+    explicit FixedPolynomial(const Polynomial<T, Alloc> &other) : data{} {
+        if (other.Degree() > static_cast<long long int>(N)) {
+            throw std::invalid_argument("Degree exceeds fixed size");
         }
-        return ans;
+        std::copy(other.begin(), other.end(), data.begin());
     }
 
-    Polynomial operator & (const Polynomial& other) const {
-        if ((*this).Degree() == -1) {
-            return Polynomial();
-        } else if (other.Degree() == -1) {
-            return Polynomial((*this)[0]);
-        } else {
-            Polynomial<T> ans((*this)[0]);
-            for (long long int i = 1; i <= (*this).Degree(); ++i) {
-                ans += (*this)[i] * other.power(i);
+    template<typename Alloc>
+    operator Polynomial<T, Alloc>() const {
+        return Polynomial<T, Alloc>(data.begin(), data.end());
+    }
+
+    constexpr T operator[](size_t i) const {
+        return i <= N ? data[i] : T(0);
+    }
+
+    constexpr long long int Degree() const {
+        for (size_t i = N + 1; i-- != 0;) {
+            if (data[i] != T(0)) {
+                return i;
             }
-            return ans;
         }
+        return -1;
     }
 
-    Polynomial operator / (const Polynomial& divider) const {
-        if (divider.Degree() == -1) {
-            throw std::invalid_argument("Division by zero");
-        } else {
-            Polynomial<T> ans;
-            Polynomial<T> reminder = *this;
-            while (reminder.Degree() >= divider.Degree()) {
-                std::vector<T> temp(size_t(reminder.Degree() - divider.Degree() + 1));
-                temp[temp.size() - 1] = reminder[reminder.Degree()] / divider[divider.Degree()];
-                ans += Polynomial(temp);
-                reminder -= Polynomial(temp) * divider;
+    constexpr auto begin() const {
+        return data.begin();
+    }
+
+    constexpr auto end() const {
+        return data.end();
+    }
+
+    constexpr T operator()(const T &x) const {
+        return horner(x, std::make_index_sequence<N>());
+    }
+
+    template<size_t M>
+    constexpr bool operator==(const FixedPolynomial<T, M> &other) const {
+        for (size_t i = 0; i <= std::max(N, M); ++i) {
+            if ((*this)[i] != other[i]) {
+                return false;
             }
-            return ans;
         }
+        return true;
     }
 
-    Polynomial operator % (const Polynomial& divider) const {
-        if (divider.Degree() == -1) {
-            throw std::invalid_argument("Division by zero");
-        } else {
-            Polynomial<T> ans;
-            Polynomial<T> reminder = *this;
-            while (reminder.Degree() >= divider.Degree()) {
-                std::vector<T> temp(size_t(reminder.Degree() - divider.Degree() + 1));
-                temp[temp.size() - 1] = reminder[reminder.Degree()] / divider[divider.Degree()];
-                ans += Polynomial(temp);
-                reminder -= Polynomial(temp) * divider;
-            }
-            return reminder;
+    template<size_t M>
+    constexpr bool operator!=(const FixedPolynomial<T, M> &other) const {
+        return !(*this == other);
+    }
+
+    template<size_t M, typename = std::enable_if_t<(M <= N)>>
+    constexpr FixedPolynomial &operator+=(const FixedPolynomial<T, M> &other) {
+        for (size_t i = 0; i <= M; ++i) {
+            data[i] += other.data[i];
+        }
+        return *this;
+    }
+
+    template<size_t M, typename = std::enable_if_t<(M <= N)>>
+    constexpr FixedPolynomial &operator-=(const FixedPolynomial<T, M> &other) {
+        for (size_t i = 0; i <= M; ++i) {
+            data[i] -= other.data[i];
+        }
+        return *this;
+    }
+
+    constexpr FixedPolynomial &operator+=(const T &scalar) {
+        data[0] += scalar;
+        return *this;
+    }
+
+    constexpr FixedPolynomial &operator-=(const T &scalar) {
+        data[0] -= scalar;
+        return *this;
+    }
+
+    constexpr FixedPolynomial &operator*=(const T &scalar) {
+        for (auto &x : data) {
+            x *= scalar;
+        }
+        return *this;
+    }
+
+    constexpr FixedPolynomial operator-() const {
+        FixedPolynomial ans;
+        for (size_t i = 0; i <= N; ++i) {
+            ans.data[i] = -data[i];
         }
+        return ans;
     }
 
-    friend Polynomial operator,(const Polynomial<T>& first, const Polynomial<T>& second) {
-        Polynomial<T> ans = first;
-        Polynomial<T> copy = second;
+    template<size_t M>
+    constexpr FixedPolynomial<T, std::max(N, M)> operator+(const FixedPolynomial<T, M> &other) const {
+        FixedPolynomial<T, std::max(N, M)> ans;
+        for (size_t i = 0; i <= std::max(N, M); ++i) {
+            ans.data[i] = (*this)[i] + other[i];
+        }
+        return ans;
+    }
 
-        while (!copy.data.empty()) {
-            ans = ans % copy;
-            std::swap(ans, copy);
+    template<size_t M>
+    constexpr FixedPolynomial<T, std::max(N, M)> operator-(const FixedPolynomial<T, M> &other) const {
+        FixedPolynomial<T, std::max(N, M)> ans;
+        for (size_t i = 0; i <= std::max(N, M); ++i) {
+            ans.data[i] = (*this)[i] - other[i];
         }
-        if (!ans.data.empty()) {
-            Polynomial<T> temp(ans[ans.data.size() - 1]);
-            ans = ans /  temp;
+        return ans;
+    }
+
+    template<size_t M>
+    constexpr FixedPolynomial<T, N + M> operator*(const FixedPolynomial<T, M> &other) const {
+        FixedPolynomial<T, N + M> ans;
+        for (size_t i = 0; i <= N; ++i) {
+            for (size_t j = 0; j <= M; ++j) {
+                ans.data[i + j] += data[i] * other.data[j];
+            }
         }
         return ans;
     }
+
+    constexpr FixedPolynomial operator+(const T &scalar) const {
+        return FixedPolynomial(*this) += scalar;
+    }
+
+    constexpr FixedPolynomial operator-(const T &scalar) const {
+        return FixedPolynomial(*this) -= scalar;
+    }
+
+    constexpr FixedPolynomial operator*(const T &scalar) const {
+        return FixedPolynomial(*this) *= scalar;
+    }
+
+    friend constexpr FixedPolynomial operator+(const T &scalar, const FixedPolynomial &p) {
+        return p + scalar;
+    }
+
+    friend constexpr FixedPolynomial operator-(const T &scalar, const FixedPolynomial &p) {
+        return -p + scalar;
+    }
+
+    friend constexpr FixedPolynomial operator*(const T &scalar, const FixedPolynomial &p) {
+        return p * scalar;
+    }
+
+    template<typename Alloc>
+    friend Polynomial<T, Alloc> operator+(const FixedPolynomial &first, const Polynomial<T, Alloc> &second) {
+        Polynomial<T, Alloc> ans(first.begin(), first.end(), second.get_allocator());
+        ans += second;
+        return ans;
+    }
+
+    template<typename Alloc>
+    friend Polynomial<T, Alloc> operator+(const Polynomial<T, Alloc> &first, const FixedPolynomial &second) {
+        return second + first;
+    }
+
+    template<typename Alloc>
+    friend Polynomial<T, Alloc> operator-(const FixedPolynomial &first, const Polynomial<T, Alloc> &second) {
+        Polynomial<T, Alloc> ans(first.begin(), first.end(), second.get_allocator());
+        ans -= second;
+        return ans;
+    }
+
+    template<typename Alloc>
+    friend Polynomial<T, Alloc> operator-(const Polynomial<T, Alloc> &first, const FixedPolynomial &second) {
+        Polynomial<T, Alloc> ans(first);
+        ans -= Polynomial<T, Alloc>(second.begin(), second.end(), first.get_allocator());
+        return ans;
+    }
+
+    template<typename Alloc>
+    friend Polynomial<T, Alloc> operator*(const FixedPolynomial &first, const Polynomial<T, Alloc> &second) {
+        return Polynomial<T, Alloc>(first.begin(), first.end(), second.get_allocator()) * second;
+    }
+
+    template<typename Alloc>
+    friend Polynomial<T, Alloc> operator*(const Polynomial<T, Alloc> &first, const FixedPolynomial &second) {
+        return first * Polynomial<T, Alloc>(second.begin(), second.end(), first.get_allocator());
+    }
+
+    template<typename Alloc>
+    friend bool operator==(const FixedPolynomial &first, const Polynomial<T, Alloc> &second) {
+        if (first.Degree() != second.Degree()) {
+            return false;
+        }
+        return std::equal(second.begin(), second.end(), first.begin());
+    }
+
+    template<typename Alloc>
+    friend bool operator==(const Polynomial<T, Alloc> &first, const FixedPolynomial &second) {
+        return second == first;
+    }
+
+    template<typename Alloc>
+    friend bool operator!=(const FixedPolynomial &first, const Polynomial<T, Alloc> &second) {
+        return !(first == second);
+    }
+
+    template<typename Alloc>
+    friend bool operator!=(const Polynomial<T, Alloc> &first, const FixedPolynomial &second) {
+        return !(first == second);
+    }
 };
 
-template<typename T>
-std::ostream& operator << (std::ostream& out, const Polynomial<T>& f) {
+template<typename T, typename Alloc>
+std::ostream& operator << (std::ostream& out, const Polynomial<T, Alloc>& f) {
     if (f.Degree() == -1) {
         out << T(0);
     } else if (f.Degree() == 0) {
@@ -348,3 +3792,44 @@ std::ostream& operator << (std::ostream& out, const Polynomial<T>& f) {
     }
     return out;
 }
+
+template<typename E, typename = enable_if_expression<E>>
+std::ostream& operator << (std::ostream& out, const E& expr) {
+    return out << expr.eval();
+}
+
+template<typename T, size_t N>
+std::ostream& operator << (std::ostream& out, const FixedPolynomial<T, N>& f) {
+    return out << Polynomial<T>(f.begin(), f.end());
+}
+
+namespace pmr {
+
+template<typename T>
+using Polynomial = dense::Polynomial<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T>
+using SubproductTree = dense::SubproductTree<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T>
+using Modulus = dense::Modulus<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T>
+using PolynomialBatch = dense::PolynomialBatch<T, std::pmr::polymorphic_allocator<T>>;
+
+}
+
+}
+
+#ifndef POLYNOMIAL_NO_GLOBAL_ALIAS
+#ifndef POLYNOMIAL_GLOBAL_ALIAS
+#define POLYNOMIAL_GLOBAL_ALIAS
+using dense::Polynomial;
+#endif
+using dense::SubproductTree;
+using dense::Modulus;
+using dense::PolynomialBatch;
+using dense::FixedPolynomial;
+using dense::ModInt;
+using dense::ThreadPool;
+#endif
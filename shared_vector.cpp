@@ -0,0 +1,205 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+namespace polynomial::detail {
+
+template<typename Vector, size_t Threshold = 0>
+class SharedVector {
+public:
+    using value_type = typename Vector::value_type;
+    using allocator_type = typename Vector::allocator_type;
+
+private:
+    using Traits = std::allocator_traits<allocator_type>;
+
+    Vector local;
+    std::shared_ptr<Vector> shared;
+
+    static std::shared_ptr<Vector> make(Vector &&input) {
+        allocator_type alloc = input.get_allocator();
+        return std::allocate_shared<Vector>(alloc, std::move(input));
+    }
+
+    void adopt(const SharedVector &other) {
+        if (other.shared && get_allocator() == other.get_allocator()) {
+            local.clear();
+            shared = other.shared;
+        } else {
+            shared.reset();
+            local.assign(other.begin(), other.end());
+            if (local.size() > Threshold) {
+                shared = make(std::move(local));
+            }
+        }
+    }
+
+    Vector &promote() {
+        if (!shared) {
+            shared = make(std::move(local));
+        } else if (shared.use_count() != 1) {
+            shared = make(Vector(*shared, get_allocator()));
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *shared;
+    }
+
+    Vector &target(size_t n) {
+        if (!shared && n <= Threshold) {
+            return local;
+        }
+        return promote();
+    }
+
+public:
+    explicit SharedVector(const allocator_type &alloc = allocator_type()) : local(alloc) {
+    }
+
+    explicit SharedVector(Vector &&input) : local(std::move(input)) {
+        if (local.size() > Threshold) {
+            shared = make(std::move(local));
+        }
+    }
+
+    SharedVector(const SharedVector &other)
+            : SharedVector(other, Traits::select_on_container_copy_construction(other.get_allocator())) {
+    }
+
+    SharedVector(const SharedVector &other, const allocator_type &alloc) : local(alloc) {
+        adopt(other);
+    }
+
+    SharedVector(SharedVector &&other) noexcept(std::is_nothrow_move_constructible_v<Vector>)
+            : local(std::move(other.local)), shared(std::move(other.shared)) {
+    }
+
+    SharedVector(SharedVector &&other, const allocator_type &alloc) : local(std::move(other.local), alloc) {
+        if (get_allocator() == other.get_allocator()) {
+            shared = std::move(other.shared);
+        } else if (other.shared) {
+            adopt(other);
+            other.shared.reset();
+        }
+    }
+
+    SharedVector &operator=(const SharedVector &other) {
+        if (this != &other) {
+            if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+                local = other.local;
+            }
+            adopt(other);
+        }
+        return *this;
+    }
+
+    SharedVector &operator=(SharedVector &&other) {
+        if (this != &other) {
+            if (Traits::propagate_on_container_move_assignment::value ||
+                get_allocator() == other.get_allocator()) {
+                local = std::move(other.local);
+                shared = std::move(other.shared);
+            } else {
+                adopt(other);
+                other.shared.reset();
+                other.local.clear();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const {
+        return local.get_allocator();
+    }
+
+    const Vector &get() const {
+        return shared ? *shared : local;
+    }
+
+    size_t size() const {
+        return get().size();
+    }
+
+    bool empty() const {
+        return get().empty();
+    }
+
+    size_t capacity() const {
+        return get().capacity();
+    }
+
+    const value_type &operator[](size_t i) const {
+        return get()[i];
+    }
+
+    const value_type &back() const {
+        return get().back();
+    }
+
+    const value_type *data() const {
+        return get().data();
+    }
+
+    auto begin() const {
+        return get().begin();
+    }
+
+    auto end() const {
+        return get().end();
+    }
+
+    auto rbegin() const {
+        return get().rbegin();
+    }
+
+    auto rend() const {
+        return get().rend();
+    }
+
+    value_type *write() {
+        return target(size()).data();
+    }
+
+    Vector &mutate() {
+        return target(Threshold + 1);
+    }
+
+    void reserve(size_t n) {
+        target(n).reserve(n);
+    }
+
+    void resize(size_t n) {
+        target(n).resize(n);
+    }
+
+    void push_back(const value_type &value) {
+        target(size() + 1).push_back(value);
+    }
+
+    void clear() {
+        if (shared && shared.use_count() != 1) {
+            shared.reset();
+        } else {
+            target(0).clear();
+        }
+    }
+
+    template<typename Iter, typename = typename std::iterator_traits<Iter>::iterator_category>
+    void assign(Iter first, Iter last) {
+        clear();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<Iter>::iterator_category>) {
+            reserve(std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+};
+
+}
@@ -1,28 +1,240 @@
+#pragma once
+
 #include <iostream>
 #include <vector>
 #include <stdexcept>
-#include <map>
 #include <algorithm>
+#include <utility>
+#include <tuple>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <limits>
 
-template<typename T>
+#include "shared_vector.cpp"
+
+namespace sparse {
+
+template<typename T, typename Alloc = std::allocator<T>>
 class Polynomial {
 private:
-    std::map<size_t, T> data;
+    using Term = std::pair<size_t, T>;
+
+    template<typename U>
+    using Rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+    using Terms = std::vector<Term, Rebind<Term>>;
 
-    void delete_zeros(std::map<size_t, T> &v) {
-        auto it = v.begin();
-        while ((it = std::find_if(it, v.end(), [](std::pair<size_t, T> p) {
+    polynomial::detail::SharedVector<Terms> data;
+
+    void delete_zeros(Terms &v) {
+        v.erase(std::remove_if(v.begin(), v.end(), [](const Term &p) {
             return p.second == T(0);
-        })) != v.end())
-            v.erase(it++);
+        }), v.end());
+    }
+
+    template<typename Func>
+    void merge(const Polynomial &other, Func combine) {
+        if (&other == this) {
+            merge(Polynomial(other, get_allocator()), combine);
+            return;
+        }
+        if (other.data.empty()) {
+            return;
+        }
+        Terms &v = data.mutate();
+        size_t n = v.size(), m = other.data.size(), size = n + m;
+        for (size_t i = 0, j = 0; i != n && j != m;) {
+            if (v[i].first < other.data[j].first) {
+                ++i;
+            } else if (other.data[j].first < v[i].first) {
+                ++j;
+            } else {
+                ++i, ++j, --size;
+            }
+        }
+        v.resize(size);
+        size_t i = n, j = m, k = size;
+        while (j != 0) {
+            if (i != 0 && v[i - 1].first > other.data[j - 1].first) {
+                --i, --k;
+                if (i != k) {
+                    v[k] = std::move(v[i]);
+                }
+            } else {
+                size_t deg = other.data[--j].first;
+                T val = T(0);
+                if (i != 0 && v[i - 1].first == deg) {
+                    val = std::move(v[--i].second);
+                }
+                combine(val, other.data[j].second);
+                if (val != T(0)) {
+                    v[--k] = Term(deg, std::move(val));
+                }
+            }
+        }
+        std::move(v.begin() + k, v.end(), v.begin() + i);
+        v.resize(i + size - k);
+    }
+
+    static void multiply(const Terms &a, const Terms &b, Terms &res) {
+        const Terms &f = a.size() <= b.size() ? a : b;
+        const Terms &g = &f == &a ? b : a;
+
+        using Entry = std::tuple<size_t, size_t, size_t>;
+        auto later = std::greater<Entry>();
+        std::vector<Entry, Rebind<Entry>> heap(1, Entry(f[0].first + g[0].first, 0, 0), res.get_allocator());
+
+        while (!heap.empty()) {
+            size_t deg = std::get<0>(heap.front());
+            T val = T(0);
+            while (!heap.empty() && std::get<0>(heap.front()) == deg) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                auto[cur, i, j] = heap.back();
+                heap.pop_back();
+                val += f[i].second * g[j].second;
+                if (j == 0 && i + 1 != f.size()) {
+                    heap.emplace_back(f[i + 1].first + g[0].first, i + 1, 0);
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+                if (j + 1 != g.size()) {
+                    heap.emplace_back(f[i].first + g[j + 1].first, i, j + 1);
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+            if (val != T(0)) {
+                res.emplace_back(deg, val);
+            }
+        }
+    }
+
+    template<typename U, typename A>
+    static void multiply_by_power(U &value, std::vector<U, A> &squares, size_t gap) {
+        for (size_t k = 0; gap != 0; ++k, gap >>= 1) {
+            if (k == squares.size()) {
+                squares.push_back(squares.back() * squares.back());
+            }
+            if (gap & 1) {
+                value *= squares[k];
+            }
+        }
+    }
+
+    static T checked_multiply(const T &x, const T &y) {
+        if constexpr (std::numeric_limits<T>::is_bounded) {
+            const T ax = x < T(0) ? T(-x) : x, ay = y < T(0) ? T(-y) : y;
+            if (ay != T(0) && ax > std::numeric_limits<T>::max() / ay) {
+                throw std::overflow_error("Coefficients are too large for integer gcd");
+            }
+        }
+        return x * y;
+    }
+
+    static T checked_subtract(const T &x, const T &y) {
+        if constexpr (std::numeric_limits<T>::is_bounded) {
+            const T top = std::numeric_limits<T>::max();
+            bool overflow;
+            if constexpr (std::numeric_limits<T>::is_signed) {
+                overflow = y > T(0) ? x < y - top : x > top + y;
+            } else {
+                overflow = x < y;
+            }
+            if (overflow) {
+                throw std::overflow_error("Coefficients are too large for integer gcd");
+            }
+        }
+        return x - y;
+    }
+
+    static T integer_gcd(T a, T b) {
+        a = a < T(0) ? checked_subtract(T(0), a) : a;
+        b = b < T(0) ? checked_subtract(T(0), b) : b;
+        while (b != T(0)) {
+            a %= b;
+            std::swap(a, b);
+        }
+        return a;
+    }
+
+    static T content(const Polynomial &p) {
+        T ans = T(0);
+        for (auto it = p.data.begin(); it != p.data.end() && ans != T(1); ++it) {
+            ans = integer_gcd(ans, it->second);
+        }
+        return ans;
+    }
+
+    static Polynomial primitive_part(Polynomial p) {
+        if (!p.data.empty()) {
+            T c = content(p);
+            if (p.data.back().second < T(0)) {
+                c = -c;
+            }
+            for (auto &term : p.data.mutate()) {
+                term.second /= c;
+            }
+        }
+        return p;
+    }
+
+    static Polynomial pseudo_remainder(Polynomial a, const Polynomial &b) {
+        const Terms &g = b.data.get();
+        const size_t top = g.back().first;
+        const T &lead = g.back().second;
+        while (!a.data.empty() && a.data.back().first >= top) {
+            const Terms &f = a.data.get();
+            const size_t shift = f.back().first - top;
+            const T coef = f.back().second;
+            Polynomial next(a.get_allocator());
+            Terms &rest = next.data.mutate();
+            size_t i = 0, j = 0;
+            while (i + 1 < f.size() || j + 1 < g.size()) {
+                if (j + 1 == g.size() || (i + 1 < f.size() && f[i].first < g[j].first + shift)) {
+                    rest.emplace_back(f[i].first, checked_multiply(f[i].second, lead));
+                    ++i;
+                } else if (i + 1 == f.size() || g[j].first + shift < f[i].first) {
+                    rest.emplace_back(g[j].first + shift, checked_subtract(T(0), checked_multiply(coef, g[j].second)));
+                    ++j;
+                } else {
+                    T val = checked_subtract(checked_multiply(f[i].second, lead), checked_multiply(coef, g[j].second));
+                    if (val != T(0)) {
+                        rest.emplace_back(f[i].first, val);
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+            a = std::move(next);
+        }
+        return a;
+    }
+
+    static Polynomial gcd_primitive(const Polynomial &first, const Polynomial &second) {
+        T c = integer_gcd(content(first), content(second));
+        Polynomial a = primitive_part(Polynomial(first, first.get_allocator()));
+        Polynomial b = primitive_part(Polynomial(second, first.get_allocator()));
+        if (a.Degree() < b.Degree()) {
+            std::swap(a, b);
+        }
+        while (!b.data.empty()) {
+            Polynomial r = primitive_part(pseudo_remainder(std::move(a), b));
+            a = std::move(b);
+            b = std::move(r);
+        }
+        for (auto &term : a.data.mutate()) {
+            term.second = checked_multiply(term.second, c);
+        }
+        return a;
     }
 
 public:
-    explicit Polynomial(const std::vector<T> &input) {
+    using allocator_type = Alloc;
+
+    explicit Polynomial(const std::vector<T> &input, const Alloc &alloc = Alloc()) : data(alloc) {
         size_t i = 0;
         for (auto it = input.begin(); it != input.end(); ++it) {
             if (*it != T(0)) {
-                data[i] = *it;
+                data.push_back(Term(i, *it));
                 ++i;
             } else {
                 ++i;
@@ -30,20 +242,21 @@ public:
         }
     }
 
-    explicit Polynomial(const T &scalar = T()) {
-        if (scalar == T(0)) {
-            data = {};
-        } else {
-            data[0] = scalar;
+    explicit Polynomial(const T &scalar = T(), const Alloc &alloc = Alloc()) : data(alloc) {
+        if (scalar != T(0)) {
+            data.push_back(Term(0, scalar));
         }
     }
 
+    explicit Polynomial(const Alloc &alloc) : data(alloc) {
+    }
+
     template<typename Iter>
-    Polynomial(Iter first, Iter last) {
+    Polynomial(Iter first, Iter last, const Alloc &alloc = Alloc()) : data(alloc) {
         size_t i = 0;
         for (auto it = first; it != last; ++it) {
             if (*it != T(0)) {
-                data[i] = *it;
+                data.push_back(Term(i, *it));
                 ++i;
             } else {
                 ++i;
@@ -51,6 +264,24 @@ public:
         }
     }
 
+    Polynomial(const Polynomial &other) = default;
+
+    Polynomial(Polynomial &&other) = default;
+
+    Polynomial(const Polynomial &other, const Alloc &alloc) : data(other.data, alloc) {
+    }
+
+    Polynomial(Polynomial &&other, const Alloc &alloc) : data(std::move(other.data), alloc) {
+    }
+
+    Polynomial &operator=(const Polynomial &other) = default;
+
+    Polynomial &operator=(Polynomial &&other) = default;
+
+    allocator_type get_allocator() const {
+        return data.get_allocator();
+    }
+
     bool operator==(const Polynomial &other) const {
         if (data.size() != other.data.size()) {
             return false;
@@ -86,18 +317,21 @@ public:
     }
 
     T operator[](size_t i) const {
-        if (data.find(i) == data.end()) {
+        auto it = std::lower_bound(data.begin(), data.end(), i, [](const Term &p, size_t deg) {
+            return p.first < deg;
+        });
+        if (it == data.end() || it->first != i) {
             return T(0);
         } else {
-            return data.at(i);
+            return it->second;
         }
     }
 
-    int Degree() const {
+    long long int Degree() const {
         if (data.empty()) {
             return -1;
         } else {
-            return (--data.end())->first;
+            return data.back().first;
         }
     }
 
@@ -110,103 +344,165 @@ public:
     }
 
     Polynomial &operator+=(const Polynomial &other) {
-        for (auto it = other.data.begin(); it != other.data.end(); ++it) {
-            auto[deg, val] = *it;
-            data[deg] += val;
-        }
-        delete_zeros(data);
+        merge(other, [](T &acc, const T &val) {
+            acc += val;
+        });
         return *this;
     }
 
     Polynomial &operator+=(const T &scalar) {
-        return *this += Polynomial(scalar);
+        Terms &v = data.mutate();
+        if (v.empty() || v[0].first != 0) {
+            v.insert(v.begin(), Term(0, T(0)));
+        }
+        v[0].second += scalar;
+        if (v[0].second == T(0)) {
+            v.erase(v.begin());
+        }
+        return *this;
     }
 
 
     Polynomial &operator-=(const Polynomial &other) {
-        for (auto it = other.data.begin(); it != other.data.end(); ++it) {
-            auto[deg, val] = *it;
-            data[deg] -= val;
-        }
-        delete_zeros(data);
+        merge(other, [](T &acc, const T &val) {
+            acc -= val;
+        });
         return *this;
     }
 
     Polynomial &operator-=(const T &scalar) {
-        return *this -= Polynomial(scalar);
+        Terms &v = data.mutate();
+        if (v.empty() || v[0].first != 0) {
+            v.insert(v.begin(), Term(0, T(0)));
+        }
+        v[0].second -= scalar;
+        if (v[0].second == T(0)) {
+            v.erase(v.begin());
+        }
+        return *this;
     }
 
-    Polynomial operator+(const Polynomial &other) const {
-        Polynomial temp = *this;
+    Polynomial operator+(const Polynomial &other) const & {
+        Polynomial temp(*this, get_allocator());
         temp += other;
         return temp;
     }
 
-    Polynomial operator+(const T &scalar) const {
-        return *this + Polynomial(scalar);
+    Polynomial operator+(const Polynomial &other) && {
+        *this += other;
+        return std::move(*this);
+    }
+
+    friend Polynomial operator+(const Polynomial &first, Polynomial &&second) {
+        second += first;
+        return std::move(second);
+    }
+
+    friend Polynomial operator+(Polynomial &&first, Polynomial &&second) {
+        first += second;
+        return std::move(first);
+    }
+
+    Polynomial operator+(const T &scalar) const & {
+        Polynomial temp(*this, get_allocator());
+        temp += scalar;
+        return temp;
+    }
+
+    Polynomial operator+(const T &scalar) && {
+        *this += scalar;
+        return std::move(*this);
     }
 
     friend Polynomial operator+(const T &scalar, const Polynomial &expr) {
-        return Polynomial(scalar) + expr;
+        return expr + scalar;
     }
 
-    Polynomial operator-(const Polynomial &other) const {
-        Polynomial temp = *this;
+    friend Polynomial operator+(const T &scalar, Polynomial &&expr) {
+        expr += scalar;
+        return std::move(expr);
+    }
+
+    Polynomial operator-(const Polynomial &other) const & {
+        Polynomial temp(*this, get_allocator());
         temp -= other;
         return temp;
     }
 
-    Polynomial operator-(const T &scalar) const {
-        return *this - Polynomial(scalar);
+    Polynomial operator-(const Polynomial &other) && {
+        *this -= other;
+        return std::move(*this);
+    }
+
+    friend Polynomial operator-(Polynomial &&first, Polynomial &&second) {
+        first -= second;
+        return std::move(first);
+    }
+
+    Polynomial operator-(const T &scalar) const & {
+        Polynomial temp(*this, get_allocator());
+        temp -= scalar;
+        return temp;
+    }
+
+    Polynomial operator-(const T &scalar) && {
+        *this -= scalar;
+        return std::move(*this);
     }
 
     friend Polynomial operator-(const T &scalar, const Polynomial &expr) {
-        return Polynomial(scalar) - expr;
+        return scalar - Polynomial(expr, expr.get_allocator());
+    }
+
+    friend Polynomial operator-(const T &scalar, Polynomial &&expr) {
+        expr *= T(0) - T(1);
+        expr += scalar;
+        return std::move(expr);
     }
 
     Polynomial &operator*=(const Polynomial &other) {
-        if (data.empty() || other.data.empty()) {
-            data = {};
-        } else {
-            std::map<size_t, T> temp;
-            for (auto it = other.data.begin(); it != other.data.end(); ++it) {
-                for (auto jt = data.begin(); jt != data.end(); ++jt) {
-                    auto[deg1, val1] = *it;
-                    auto[deg2, val2] = *jt;
-                    temp[deg1 + deg2] += val1 * val2;
-                }
-            }
-            delete_zeros(temp);
-            data = temp;
-        }
-        return *this;
+        return *this = *this * other;
     }
 
     Polynomial &operator*=(const T &scalar) {
         if (scalar == T(0)) {
-            *this = Polynomial();
+            data.clear();
         } else {
-            (*this) *= Polynomial(scalar);
+            Terms &v = data.mutate();
+            for (auto it = v.begin(); it != v.end(); ++it) {
+                it->second *= scalar;
+            }
+            delete_zeros(v);
         }
         return *this;
     }
 
     Polynomial operator*(const Polynomial &other) const {
-        Polynomial<T> temp = *this;
-        temp *= other;
-        return temp;
+        Polynomial ans(get_allocator());
+        if (!data.empty() && !other.data.empty()) {
+            multiply(data.get(), other.data.get(), ans.data.mutate());
+        }
+        return ans;
     }
 
-    Polynomial operator*(const T &scalar) const {
-        Polynomial<T> temp = *this;
+    Polynomial operator*(const T &scalar) const & {
+        Polynomial temp(*this, get_allocator());
         temp *= scalar;
         return temp;
     }
 
+    Polynomial operator*(const T &scalar) && {
+        *this *= scalar;
+        return std::move(*this);
+    }
+
     friend Polynomial operator*(const T &scalar, const Polynomial &other) {
-        Polynomial<T> temp = other;
-        temp *= scalar;
-        return temp;
+        return other * scalar;
+    }
+
+    friend Polynomial operator*(const T &scalar, Polynomial &&other) {
+        other *= scalar;
+        return std::move(other);
     }
 
     T operator ()(const T& scalar) const {
@@ -215,90 +511,162 @@ public:
         } else {
             T ans = T(0);
             T temp = T(1);
+            std::vector<T, Rebind<T>> squares(1, scalar, get_allocator());
             size_t ind = 0;
             for (auto it = data.begin(); it != data.end(); ++it) {
                 auto[deg, val] = *it;
-                while (ind != deg) {
-                    temp *= scalar;
-                    ++ind;
-                }
+                multiply_by_power(temp, squares, deg - ind);
+                ind = deg;
                 ans += val * temp;
             }
             return ans;
         }
     }
 
+    Polynomial power(long long int n) const {
+        if (n < 0) {
+            throw std::invalid_argument("Negative exponent");
+        }
+        Polynomial ans(T(1), get_allocator());
+        Polynomial base(*this, get_allocator());
+        while (n != 0) {
+            if (n & 1) {
+                ans *= base;
+            }
+            n >>= 1;
+            if (n != 0) {
+                base *= base;
+            }
+        }
+        return ans;
+    }
+
+    Polynomial powmod(long long int n, const Polynomial& modulus) const {
+        if (n < 0) {
+            throw std::invalid_argument("Negative exponent");
+        }
+        Polynomial ans = Polynomial(T(1), get_allocator()) % modulus;
+        Polynomial base = *this % modulus;
+        while (n != 0) {
+            if (n & 1) {
+                ans = ans * base % modulus;
+            }
+            n >>= 1;
+            if (n != 0) {
+                base = base * base % modulus;
+            }
+        }
+        return ans;
+    }
+
     Polynomial operator & (const Polynomial& other) const {
         if (Degree() == -1) {
-            return Polynomial();
+            return Polynomial(get_allocator());
         } else {
-            Polynomial<T> ans;
-            Polynomial<T> temp(T(1));
+            Polynomial ans(get_allocator());
+            Polynomial temp(T(1), get_allocator());
+            std::vector<Polynomial, Rebind<Polynomial>> squares(get_allocator());
+            squares.push_back(other);
             size_t ind = 0;
             for (auto it = data.begin(); it != data.end(); ++it) {
                 auto[deg, val] = *it;
-                while (ind != deg) {
-                    temp *= other;
-                    ++ind;
-                }
+                multiply_by_power(temp, squares, deg - ind);
+                ind = deg;
                 ans += val * temp;
             }
             return ans;
         }
     }
 
-    Polynomial operator / (const Polynomial& divider) const {
+    std::pair<Polynomial, Polynomial> divmod(const Polynomial& divider) const {
         if (divider.Degree() == -1) {
             throw std::invalid_argument("Division by zero");
         } else {
-            Polynomial<T> ans;
-            Polynomial<T> reminder = *this;
-            while (reminder.Degree() >= divider.Degree()) {
-                Polynomial<T> temp;
-                temp.data[reminder.Degree() - divider.Degree()] = reminder[reminder.Degree()]
-                        / divider[divider.Degree()];
-                ans += Polynomial(temp);
-                reminder -= Polynomial(temp) * divider;
+            const Terms &g = divider.data.get();
+            const size_t top = g.back().first;
+            const T lead = g.back().second;
+
+            using Entry = std::tuple<size_t, size_t, size_t>;
+            std::vector<Entry, Rebind<Entry>> heap(get_allocator());
+            Polynomial ans(get_allocator()), reminder(get_allocator());
+            Terms &quotient = ans.data.mutate(), &rest = reminder.data.mutate();
+            auto it = data.rbegin();
+            while (it != data.rend() || !heap.empty()) {
+                size_t deg = it != data.rend() ? it->first : 0;
+                if (!heap.empty()) {
+                    deg = std::max(deg, std::get<0>(heap.front()));
+                }
+
+                T val = T(0);
+                if (it != data.rend() && it->first == deg) {
+                    val = (it++)->second;
+                }
+                while (!heap.empty() && std::get<0>(heap.front()) == deg) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    auto[cur, i, j] = heap.back();
+                    heap.pop_back();
+                    val -= quotient[i].second * g[g.size() - 1 - j].second;
+                    if (j + 1 != g.size()) {
+                        heap.emplace_back(quotient[i].first + g[g.size() - 2 - j].first, i, j + 1);
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+
+                if (deg >= top) {
+                    T coef = val / lead;
+                    if (coef != T(0)) {
+                        quotient.emplace_back(deg - top, coef);
+                        if (g.size() > 1) {
+                            heap.emplace_back(deg - top + g[g.size() - 2].first, quotient.size() - 1, 1);
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                    }
+                    if constexpr (std::numeric_limits<T>::is_integer) {
+                        val -= coef * lead;
+                        if (val != T(0)) {
+                            rest.emplace_back(deg, val);
+                        }
+                    }
+                } else if (val != T(0)) {
+                    rest.emplace_back(deg, val);
+                }
             }
-            return ans;
+
+            std::reverse(quotient.begin(), quotient.end());
+            std::reverse(rest.begin(), rest.end());
+            return {std::move(ans), std::move(reminder)};
         }
     }
 
+    Polynomial operator / (const Polynomial& divider) const {
+        return divmod(divider).first;
+    }
+
     Polynomial operator % (const Polynomial& divider) const {
-        if (divider.Degree() == -1) {
-            throw std::invalid_argument("Division by zero");
-        } else {
-            Polynomial<T> ans;
-            Polynomial<T> reminder = *this;
-            while (reminder.Degree() >= divider.Degree()) {
-                Polynomial<T> temp;
-                temp.data[reminder.Degree() - divider.Degree()] = reminder[reminder.Degree()]
-                                                                  / divider[divider.Degree()];
-                ans += Polynomial(temp);
-                reminder -= Polynomial(temp) * divider;
-            }
-            return reminder;
-        }
+        return divmod(divider).second;
     }
 
-    friend Polynomial operator,(const Polynomial<T>& first, const Polynomial<T>& second) {
-        Polynomial<T> ans = first;
-        Polynomial<T> copy = second;
+    friend Polynomial operator,(const Polynomial& first, const Polynomial& second) {
+        if constexpr (std::numeric_limits<T>::is_integer) {
+            return gcd_primitive(first, second);
+        }
+        Polynomial ans(first, first.get_allocator());
+        Polynomial copy(second, first.get_allocator());
 
         while (!copy.data.empty()) {
             ans = ans % copy;
             std::swap(ans, copy);
         }
         if (!ans.data.empty()) {
-            Polynomial<T> temp(ans[ans.Degree()]);
+            Polynomial temp(ans[ans.Degree()], ans.get_allocator());
             ans = ans / temp;
         }
         return ans;
     }
 };
 
-template<typename T>
-std::ostream& operator << (std::ostream& out, const Polynomial<T>& f) {
+template<typename T, typename Alloc>
+std::ostream& operator << (std::ostream& out, const Polynomial<T, Alloc>& f) {
     if (f.Degree() == -1 || f.Degree() == 0) {
         out << f[0];
     } else if (f.Degree() == 1) {
@@ -360,3 +728,17 @@ std::ostream& operator << (std::ostream& out, const Polynomial<T>& f) {
     }
     return out;
 }
+
+namespace pmr {
+
+template<typename T>
+using Polynomial = sparse::Polynomial<T, std::pmr::polymorphic_allocator<T>>;
+
+}
+
+}
+
+#if !defined(POLYNOMIAL_NO_GLOBAL_ALIAS) && !defined(POLYNOMIAL_GLOBAL_ALIAS)
+#define POLYNOMIAL_GLOBAL_ALIAS
+using sparse::Polynomial;
+#endif